@@ -0,0 +1,98 @@
+// Benchmark alokasi isi Value. Loop `isi i = i + 1;` tidak boleh
+// mengalokasikan apa pun di kedua engine, dan baca/tulis elemen array hanya
+// boleh mengalokasikan storage array itu sendiri sekali.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+
+#define LOOP_COUNT 1000000
+
+static const char* loop_source =
+    "bikin fungsi main() {\n"
+    "    isi i = 0;\n"
+    "    isi total = 0.5;\n"
+    "    ulang (i < 1000000) {\n"
+    "        isi i = i + 1;\n"
+    "        isi total = total + 1.5;\n"
+    "    }\n"
+    "}\n";
+
+static const char* array_source =
+    "bikin fungsi main() {\n"
+    "    isi a = array int[16];\n"
+    "    isi i = 0;\n"
+    "    ulang (i < 1000000) {\n"
+    "        isi j = i - i / 16 * 16;\n"
+    "        a[j] = a[j] + 1;\n"
+    "        isi i = i + 1;\n"
+    "    }\n"
+    "}\n";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Jumlah alokasi selama program berjalan; ns per iterasi di *per_iter
+static size_t run(const char* source, bool tree_walk, double* per_iter) {
+    Lexer* lexer = create_lexer(source, (int)strlen(source));
+    Parser* parser = create_parser(lexer);
+    ASTNode* ast = parse(parser);
+    free_parser(parser);
+    free_lexer(lexer);
+
+    size_t before, allocations;
+    double start, elapsed;
+    if (tree_walk) {
+        Interpreter* interpreter = create_interpreter();
+        before = value_alloc_count();
+        start = now_seconds();
+        interpret(interpreter, ast);
+        elapsed = now_seconds() - start;
+        allocations = value_alloc_count() - before;
+        free_interpreter(interpreter);
+    } else {
+        Chunk* chunk = compile_program(ast);
+        VM* vm = create_vm();
+        before = value_alloc_count();
+        start = now_seconds();
+        vm_run(vm, chunk);
+        elapsed = now_seconds() - start;
+        allocations = value_alloc_count() - before;
+        free_vm(vm);
+        free_chunk(chunk);
+    }
+    free_ast(ast);
+
+    *per_iter = elapsed * 1e9 / LOOP_COUNT;
+    return allocations;
+}
+
+static int bench(const char* name, const char* source, size_t expected) {
+    const char* engines[] = { "vm", "tree-walk" };
+    for (int i = 0; i < 2; i++) {
+        double per_iter;
+        size_t allocations = run(source, i == 1, &per_iter);
+        printf("%-10s %-10s %10.2f ns/iter %8zu alokasi\n", engines[i], name,
+               per_iter, allocations);
+        if (allocations != expected) {
+            fprintf(stderr, "%s %s: %zu alokasi, seharusnya %zu\n", engines[i], name,
+                    allocations, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    if (bench("isi loop", loop_source, 0) != 0) return 1;
+    if (bench("array", array_source, 1) != 0) return 1;
+    return 0;
+}
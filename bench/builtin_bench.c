@@ -0,0 +1,91 @@
+// Benchmark pemanggilan builtin: loop yang memanggil builtin native yang
+// didaftarkan lewat register_builtin, di VM dan tree walker. Builtin sudah
+// di-resolve saat parsing, jadi pemanggilan tidak mencari nama lagi.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+#include "builtin.h"
+
+#define CALL_COUNT 1000000
+
+// total dideklarasikan pertama, jadi ada di slot/register 0 frame main
+static const char* source =
+    "bikin fungsi main() {\n"
+    "    isi total = 0;\n"
+    "    isi i = 0;\n"
+    "    ulang (i < 1000000) {\n"
+    "        isi total = total + kuadrat_mod(i);\n"
+    "        isi i = i + 1;\n"
+    "    }\n"
+    "}\n";
+
+static Value kuadrat_mod(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    result.type = TYPE_INT;
+    result.value.int_val = (args[0].value.int_val * args[0].value.int_val) % 7;
+    return result;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int expected_total(void) {
+    int total = 0;
+    for (int i = 0; i < CALL_COUNT; i++) total += (i * i) % 7;
+    return total;
+}
+
+static int bench(const char* name, bool tree_walk) {
+    Lexer* lexer = create_lexer(source, (int)strlen(source));
+    Parser* parser = create_parser(lexer);
+    ASTNode* ast = parse(parser);
+    free_parser(parser);
+    free_lexer(lexer);
+
+    Value result;
+    double start, elapsed;
+    if (tree_walk) {
+        Interpreter* interpreter = create_interpreter();
+        start = now_seconds();
+        interpret(interpreter, ast);
+        elapsed = now_seconds() - start;
+        result = interpreter->stack[0].value;
+        free_interpreter(interpreter);
+    } else {
+        Chunk* chunk = compile_program(ast);
+        VM* vm = create_vm();
+        start = now_seconds();
+        vm_run(vm, chunk);
+        elapsed = now_seconds() - start;
+        result = vm->registers[0];
+        free_vm(vm);
+        free_chunk(chunk);
+    }
+    free_ast(ast);
+
+    printf("%-16s %10.2f ns/iter\n", name, elapsed * 1e9 / CALL_COUNT);
+    if (result.type != TYPE_INT || result.value.int_val != expected_total()) {
+        fprintf(stderr, "%s: hasil builtin salah\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    const Builtin spec = { .name = "kuadrat_mod", .fn = kuadrat_mod, .min_args = 1, .max_args = 1 };
+    if (!register_builtin(&spec)) return 1;
+    if (bench("vm", false) != 0) return 1;
+    if (bench("tree-walk", true) != 0) return 1;
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Benchmark pemanggilan fungsi di VM dan tree walker: fib rekursif, dan
+// tail call `kembali f(...)` yang jauh melewati batas kedalaman. Frame
+// diambil dari stack yang dialokasikan sekali, jadi pemanggilan tidak boleh
+// mengalokasikan isi Value apa pun, dan tail call memakai ulang frame
+// pemanggilnya.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+
+typedef struct {
+    const char* name;
+    const char* source;     // hasil dideklarasikan pertama di main (slot 0)
+    int calls;
+    int result;
+} Workload;
+
+static const Workload workloads[] = {
+    { "fib(27)",
+      "fungsi_int fib(n: int) {\n"
+      "    kalo (n < 2) {\n"
+      "        kembali n;\n"
+      "    }\n"
+      "    kembali fib(n - 1) + fib(n - 2);\n"
+      "}\n"
+      "bikin fungsi main() {\n"
+      "    isi hasil = fib(27);\n"
+      "}\n",
+      635621, 196418 },
+    { "tail 1M",
+      "fungsi_int hitung(n: int, acc: int) {\n"
+      "    kalo (n < 1) {\n"
+      "        kembali acc;\n"
+      "    }\n"
+      "    kembali hitung(n - 1, acc + 1);\n"
+      "}\n"
+      "bikin fungsi main() {\n"
+      "    isi hasil = hitung(1000000, 0);\n"
+      "}\n",
+      1000001, 1000000 },
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int bench(const char* name, const Workload* workload, bool tree_walk) {
+    Lexer* lexer = create_lexer(workload->source, (int)strlen(workload->source));
+    Parser* parser = create_parser(lexer);
+    ASTNode* ast = parse(parser);
+    free_parser(parser);
+    free_lexer(lexer);
+
+    Value result;
+    size_t before = value_alloc_count();
+    double start, elapsed;
+    if (tree_walk) {
+        Interpreter* interpreter = create_interpreter();
+        start = now_seconds();
+        interpret(interpreter, ast);
+        elapsed = now_seconds() - start;
+        result = interpreter->stack[0].value;
+        free_interpreter(interpreter);
+    } else {
+        Chunk* chunk = compile_program(ast);
+        VM* vm = create_vm();
+        start = now_seconds();
+        vm_run(vm, chunk);
+        elapsed = now_seconds() - start;
+        result = vm->registers[0];
+        free_vm(vm);
+        free_chunk(chunk);
+    }
+    size_t allocations = value_alloc_count() - before;
+    free_ast(ast);
+
+    printf("%-16s %-8s %10.2f ns/call %8zu alokasi\n", name, workload->name,
+           elapsed * 1e9 / workload->calls, allocations);
+    if (result.type != TYPE_INT || result.value.int_val != workload->result) {
+        fprintf(stderr, "%s: hasil %s salah\n", name, workload->name);
+        return 1;
+    }
+    if (allocations != 0) {
+        fprintf(stderr, "%s: pemanggilan fungsi masih mengalokasikan\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+        if (bench("vm", &workloads[i], false) != 0) return 1;
+        if (bench("tree-walk", &workloads[i], true) != 0) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Benchmark rangkaian string: `isi s = s + potongan;` berulang sampai 10 MB
+// di VM dan tree walker. Append ke String yang hanya dimiliki variabel
+// harus amortized O(1), jadi waktu per append untuk 10 MB tidak boleh jauh
+// lebih besar dari untuk 1 MB (penyalinan ulang akan kuadratik).
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+
+#define PIECE_LENGTH 100
+#define SMALL_BYTES (1024 * 1024)
+#define LARGE_BYTES (10 * 1024 * 1024)
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// s dideklarasikan pertama, jadi ada di slot/register 0
+static ASTNode* parse_script(int count) {
+    char piece[PIECE_LENGTH + 1];
+    memset(piece, 'x', PIECE_LENGTH);
+    piece[PIECE_LENGTH] = '\0';
+
+    char source[512];
+    snprintf(source, sizeof(source),
+             "bikin fungsi main() {\n"
+             "    isi s = \"\";\n"
+             "    isi i = 0;\n"
+             "    ulang (i < %d) {\n"
+             "        isi s = s + \"%s\";\n"
+             "        isi i = i + 1;\n"
+             "    }\n"
+             "}\n", count, piece);
+
+    Lexer* lexer = create_lexer(source, (int)strlen(source));
+    Parser* parser = create_parser(lexer);
+    ASTNode* ast = parse(parser);
+    free_parser(parser);
+    free_lexer(lexer);
+    return ast;
+}
+
+// ns per append; negatif kalau panjang hasilnya salah
+static double run(bool tree_walk, int bytes) {
+    int count = bytes / PIECE_LENGTH;
+    ASTNode* ast = parse_script(count);
+    size_t length = 0;
+    double start, elapsed;
+
+    if (tree_walk) {
+        Interpreter* interpreter = create_interpreter();
+        start = now_seconds();
+        interpret(interpreter, ast);
+        elapsed = now_seconds() - start;
+        length = value_strlen(&interpreter->stack[0].value);
+        free_interpreter(interpreter);
+    } else {
+        Chunk* chunk = compile_program(ast);
+        VM* vm = create_vm();
+        start = now_seconds();
+        vm_run(vm, chunk);
+        elapsed = now_seconds() - start;
+        length = value_strlen(&vm->registers[0]);
+        free_vm(vm);
+        free_chunk(chunk);
+    }
+    free_ast(ast);
+
+    if (length != (size_t)count * PIECE_LENGTH) return -1;
+    return elapsed * 1e9 / count;
+}
+
+static int bench(const char* name, bool tree_walk) {
+    double small = run(tree_walk, SMALL_BYTES);
+    double large = run(tree_walk, LARGE_BYTES);
+    if (small < 0 || large < 0) {
+        fprintf(stderr, "%s: panjang string salah\n", name);
+        return 1;
+    }
+
+    printf("%-16s %8.1f MB %10.2f ns/append (1 MB: %.2f)\n", name,
+           LARGE_BYTES / (1024.0 * 1024.0), large, small);
+    if (large > small * 4) {
+        fprintf(stderr, "%s: append tidak amortized O(1)\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    if (bench("vm", false) != 0) return 1;
+    if (bench("tree-walk", true) != 0) return 1;
+    return 0;
+}
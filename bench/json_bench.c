@@ -0,0 +1,72 @@
+// Benchmark parser JSON: throughput tahap 1 (indeks struktural) dan akses
+// on-demand ke elemen terakhir array besar. Akses yang melompati subtree
+// harus jauh lebih murah daripada tahap 1 itu sendiri.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "json.h"
+
+#define RECORD_COUNT 200000
+
+static const char* record =
+    "{\"id\": %d, \"nama\": \"pengguna \\\"%d\\\"\", \"skor\": %d.5, "
+    "\"aktif\": true, \"tags\": [\"a\", \"b\", \"c\"], "
+    "\"alamat\": {\"kota\": \"Bandung\", \"kode\": [40111, 40112]}}";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char* make_document(size_t* length) {
+    size_t capacity = (size_t)RECORD_COUNT * 200 + 16;
+    char* text = malloc(capacity);
+    size_t used = 0;
+
+    text[used++] = '[';
+    for (int i = 0; i < RECORD_COUNT; i++) {
+        if (i > 0) text[used++] = ',';
+        used += snprintf(text + used, capacity - used, record, i, i, i);
+    }
+    text[used++] = ']';
+    text[used] = '\0';
+    *length = used;
+    return text;
+}
+
+int main(void) {
+    size_t length;
+    char* text = make_document(&length);
+
+    double start = now_seconds();
+    JsonDocument* doc = json_parse(text, length);
+    double index_time = now_seconds() - start;
+    if (!doc) {
+        fprintf(stderr, "Dokumen benchmark tidak valid\n");
+        return 1;
+    }
+
+    Value root = json_root(doc);
+    json_release(doc);
+
+    start = now_seconds();
+    Value last = json_get_index(&root, RECORD_COUNT - 1);
+    Value id = json_get_field(&last, "id");
+    double access_time = now_seconds() - start;
+
+    double mb = length / (1024.0 * 1024.0);
+    printf("%-16s %8.1f MB %10.2f MB/s\n", "tahap 1", mb, mb / index_time);
+    printf("%-16s %10.3f ms\n", "akses terakhir", access_time * 1e3);
+
+    bool ok = id.type == TYPE_INT && id.value.int_val == RECORD_COUNT - 1 &&
+              json_length(&root) == RECORD_COUNT;
+    release_value(&last);
+    release_value(&root);
+    if (!ok) {
+        fprintf(stderr, "Hasil akses JSON salah\n");
+        return 1;
+    }
+    return 0;
+}
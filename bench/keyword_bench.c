@@ -0,0 +1,92 @@
+// Micro-benchmark lookup_keyword dibanding rantai strcmp lama dari
+// read_identifier. Sekaligus memastikan keduanya memberi TokenType sama.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+
+#define ITERATIONS 2000000
+
+// Salinan rantai strcmp sebelum lookup_keyword, sebagai pembanding
+static TokenType strcmp_chain(const char* value) {
+    TokenType type = TOKEN_IDENTIFIER;
+    if (strcmp(value, "bikin") == 0) type = TOKEN_BIKIN;
+    else if (strcmp(value, "fungsi_int") == 0) type = TOKEN_FUNGSI_INT;
+    else if (strcmp(value, "fungsi_float") == 0) type = TOKEN_FUNGSI_FLOAT;
+    else if (strcmp(value, "fungsi_bool") == 0) type = TOKEN_FUNGSI_BOOL;
+    else if (strcmp(value, "fungsi_str") == 0) type = TOKEN_FUNGSI_STR;
+    else if (strcmp(value, "int") == 0) type = TOKEN_TYPE_INT;
+    else if (strcmp(value, "float") == 0) type = TOKEN_TYPE_FLOAT;
+    else if (strcmp(value, "bool") == 0) type = TOKEN_TYPE_BOOL;
+    else if (strcmp(value, "str") == 0) type = TOKEN_TYPE_STR;
+    else if (strcmp(value, "cetak") == 0) type = TOKEN_CETAK;
+    else if (strcmp(value, "kalo") == 0) type = TOKEN_KALO;
+    else if (strcmp(value, "maka") == 0) type = TOKEN_MAKA;
+    else if (strcmp(value, "lain") == 0) type = TOKEN_LAIN;
+    else if (strcmp(value, "ulang") == 0) type = TOKEN_ULANG;
+    else if (strcmp(value, "sampai") == 0) type = TOKEN_SAMPAI;
+    else if (strcmp(value, "fungsi") == 0) type = TOKEN_FUNGSI;
+    else if (strcmp(value, "kembali") == 0) type = TOKEN_KEMBALI;
+    else if (strcmp(value, "isi") == 0) type = TOKEN_ISI;
+    else if (strcmp(value, "benar") == 0) type = TOKEN_BENAR;
+    else if (strcmp(value, "salah") == 0) type = TOKEN_SALAH;
+    else if (strcmp(value, "array") == 0) type = TOKEN_ARRAY;
+    return type;
+}
+
+static const char* words[] = {
+    // Semua keyword
+    "bikin", "fungsi_int", "fungsi_float", "fungsi_bool", "fungsi_str",
+    "int", "float", "bool", "str", "cetak", "kalo", "maka", "lain", "ulang",
+    "sampai", "fungsi", "kembali", "isi", "benar", "salah", "array",
+    // Identifier biasa, termasuk yang mirip keyword
+    "i", "total", "hasil", "nama", "angka", "response", "post_response",
+    "data", "x", "y", "isi_data", "fungsi_x", "kalau", "bikini", "arrays",
+    "benarkah", "str2", "ints", "counter", "index", "tmp",
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    const int count = sizeof(words) / sizeof(words[0]);
+    int lengths[sizeof(words) / sizeof(words[0])];
+
+    for (int i = 0; i < count; i++) {
+        lengths[i] = (int)strlen(words[i]);
+        TokenType expected = strcmp_chain(words[i]);
+        TokenType actual = lookup_keyword(words[i], lengths[i]);
+        if (expected != actual) {
+            fprintf(stderr, "Mapping beda untuk '%s': %d vs %d\n", words[i], expected, actual);
+            return 1;
+        }
+    }
+
+    volatile unsigned long sink = 0;
+
+    double start = now_seconds();
+    for (int n = 0; n < ITERATIONS; n++) {
+        for (int i = 0; i < count; i++) {
+            sink += strcmp_chain(words[i]);
+        }
+    }
+    double chain_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int n = 0; n < ITERATIONS; n++) {
+        for (int i = 0; i < count; i++) {
+            sink += lookup_keyword(words[i], lengths[i]);
+        }
+    }
+    double switch_time = now_seconds() - start;
+
+    double lookups = (double)ITERATIONS * count;
+    printf("%-16s %10.2f ns/lookup\n", "strcmp chain", chain_time * 1e9 / lookups);
+    printf("%-16s %10.2f ns/lookup\n", "lookup_keyword", switch_time * 1e9 / lookups);
+    printf("%-16s %10.2fx\n", "speedup", chain_time / switch_time);
+    return 0;
+}
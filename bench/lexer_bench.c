@@ -0,0 +1,82 @@
+// Benchmark throughput lexer (MB/s) untuk input sintetis berbagai ukuran.
+// Throughput harus kira-kira konstan; kalau input terbesar jauh lebih
+// lambat per byte dibanding yang terkecil, lexing sudah tidak linear.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+
+static const char* snippet =
+    "fungsi_int hitung(x: int, y: int) {\n"
+    "    isi total = x * 2 + y / 3 - 1;\n"
+    "    // komentar satu baris\n"
+    "    ulang (total < 1000) {\n"
+    "        cetak(\"total sekarang\");\n"
+    "        isi total = total + 1;\n"
+    "    }\n"
+    "    kembali total;\n"
+    "}\n";
+
+static char* make_source(size_t size) {
+    size_t snippet_len = strlen(snippet);
+    char* source = malloc(size + 1);
+    size_t used = 0;
+    while (used + snippet_len <= size) {
+        memcpy(source + used, snippet, snippet_len);
+        used += snippet_len;
+    }
+    memset(source + used, ' ', size - used);
+    source[size] = '\0';
+    return source;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double measure(const char* source, size_t size, long* token_count) {
+    double best = 0;
+    for (int round = 0; round < 3; round++) {
+        Lexer* lexer = create_lexer(source, (int)size);
+        long count = 0;
+        double start = now_seconds();
+        while (get_next_token(lexer).type != TOKEN_EOF) {
+            count++;
+        }
+        double elapsed = now_seconds() - start;
+        free_lexer(lexer);
+
+        double mb_per_s = (size / (1024.0 * 1024.0)) / elapsed;
+        if (mb_per_s > best) best = mb_per_s;
+        *token_count = count;
+    }
+    return best;
+}
+
+int main(void) {
+    const size_t sizes_mb[] = {1, 4, 16, 64};
+    const int count = sizeof(sizes_mb) / sizeof(sizes_mb[0]);
+    double first = 0, last = 0;
+
+    printf("%-10s %12s %12s\n", "ukuran", "token", "MB/s");
+    for (int i = 0; i < count; i++) {
+        size_t size = sizes_mb[i] * 1024 * 1024;
+        char* source = make_source(size);
+        long tokens = 0;
+        double mb_per_s = measure(source, size, &tokens);
+        free(source);
+
+        printf("%7zu MB %12ld %12.1f\n", sizes_mb[i], tokens, mb_per_s);
+        if (i == 0) first = mb_per_s;
+        last = mb_per_s;
+    }
+
+    if (last < first * 0.5) {
+        fprintf(stderr, "Lexer tidak linear: %.1f MB/s turun ke %.1f MB/s\n", first, last);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Benchmark jalur cetak: JSON besar dan array int panjang ditulis lewat
+// buffer Output ke /dev/null. Mengukur biaya format, bukan I/O terminal.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "value.h"
+
+#define RECORD_COUNT 100000
+#define ARRAY_SIZE 1000000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char* make_json(size_t* length) {
+    size_t capacity = (size_t)RECORD_COUNT * 128 + 16;
+    char* text = malloc(capacity);
+    size_t used = 0;
+
+    text[used++] = '[';
+    for (int i = 0; i < RECORD_COUNT; i++) {
+        if (i > 0) text[used++] = ',';
+        used += snprintf(text + used, capacity - used,
+                         "{\"id\":%d,\"nama\":\"pengguna %d\",\"tags\":[\"a\",\"b\"]}", i, i);
+    }
+    text[used++] = ']';
+    text[used] = '\0';
+    *length = used;
+    return text;
+}
+
+int main(void) {
+    int fd = open("/dev/null", O_WRONLY);
+    Output* out = create_output(fd);
+    output_set_unbuffered(out, false);
+
+    size_t length;
+    char* text = make_json(&length);
+    Value json = adopt_string(text, length);
+
+    double start = now_seconds();
+    print_value(out, json);
+    output_flush(out);
+    double json_time = now_seconds() - start;
+
+    Value array = make_array(TYPE_ARRAY_INT, ARRAY_SIZE);
+    for (int i = 0; i < ARRAY_SIZE; i++) array.value.int_array[i] = i * 7 - 1000;
+
+    start = now_seconds();
+    print_value(out, array);
+    output_flush(out);
+    double array_time = now_seconds() - start;
+
+    double mb = length / (1024.0 * 1024.0);
+    printf("%-16s %8.1f MB %10.2f MB/s\n", "cetak JSON", mb, mb / json_time);
+    printf("%-16s %8d el %10.2f ns/el\n", "cetak array int", ARRAY_SIZE,
+           array_time * 1e9 / ARRAY_SIZE);
+
+    release_value(&json);
+    release_value(&array);
+    free_output(out);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Benchmark mode --serve: latensi satu request script kecil (connect, kirim,
+// jalankan, baca balasan) ke daemon yang sudah berjalan. Program sudah ada
+// di cache daemon setelah request pertama.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include "types.h"
+#include "server.h"
+
+#define REQUEST_COUNT 2000
+
+static const char* request =
+    "-\n"
+    "bikin fungsi main() {\n"
+    "    isi i = 0;\n"
+    "    ulang (i < 10) { isi i = i + 1; }\n"
+    "    cetak(i);\n"
+    "}\n";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Satu request; true kalau balasannya "10\n"
+static bool send_request(const struct sockaddr_un* addr) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (connect(fd, (const struct sockaddr*)addr, sizeof(*addr)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = strlen(request);
+    bool ok = write(fd, request, length) == (ssize_t)length;
+    shutdown(fd, SHUT_WR);
+
+    char reply[64];
+    size_t used = 0;
+    ssize_t count;
+    while (ok && used < sizeof(reply) - 1 &&
+           (count = read(fd, reply + used, sizeof(reply) - 1 - used)) > 0) {
+        used += (size_t)count;
+    }
+    close(fd);
+    reply[used] = '\0';
+    return ok && strcmp(reply, "10\n") == 0;
+}
+
+int main(void) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "/tmp/azeng_serve_%ld.sock", (long)getpid());
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDERR_FILENO);
+        _exit(serve(addr.sun_path, false, false, MAX_CALL_DEPTH));
+    }
+
+    // Tunggu socket siap; request pertama sekaligus mengisi cache program
+    bool ready = false;
+    for (int i = 0; i < 200 && !ready; i++) {
+        ready = send_request(&addr);
+        if (!ready) usleep(10000);
+    }
+
+    bool ok = ready;
+    double start = now_seconds();
+    for (int i = 0; i < REQUEST_COUNT && ok; i++) {
+        ok = send_request(&addr);
+    }
+    double elapsed = now_seconds() - start;
+
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+
+    if (!ok) {
+        fprintf(stderr, "Daemon tidak membalas dengan benar\n");
+        return 1;
+    }
+    printf("%-16s %10.1f us/request\n", "serve", elapsed * 1e6 / REQUEST_COUNT);
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Benchmark startup: source -> AST lewat lexer + parser (cold) dibandingkan
+// dengan memuat cache .azc (cached). Keduanya dihitung dari membaca file
+// sampai AST siap dijalankan, dan AST hasil cache harus identik.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lexer.h"
+#include "parser.h"
+#include "source.h"
+#include "cache.h"
+
+#define STATEMENT_COUNT 100000
+#define RUNS 3
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool write_script(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "bikin fungsi main() {\n    isi total = 0;\n");
+    for (int i = 0; i < STATEMENT_COUNT; i++) {
+        fprintf(file, "    isi v%d = %d + total * 2 - 3;\n", i % 500, i);
+        fprintf(file, "    kalo (v%d > 10) { isi total = total + v%d / 7; }\n", i % 500, i % 500);
+    }
+    fprintf(file, "    cetak(\"total: \" + \"selesai\");\n}\n");
+    return fclose(file) == 0;
+}
+
+static ASTNode* load_cold(const char* path) {
+    SourceFile source;
+    if (!load_source(path, &source)) return NULL;
+    Lexer* lexer = create_lexer(source.data, (int)source.length);
+    Parser* parser = create_parser(lexer);
+    ASTNode* ast = parse(parser);
+    free_parser(parser);
+    free_lexer(lexer);
+    unload_source(&source);
+    return ast;
+}
+
+static ASTNode* load_cached(const char* path, const char* cache_path) {
+    SourceFile source;
+    if (!load_source(path, &source)) return NULL;
+    uint64_t hash = hash_source(source.data, source.length);
+    ASTNode* ast = cache_load(cache_path, hash, source.length);
+    unload_source(&source);
+    return ast;
+}
+
+static bool same_ast(const ASTNode* a, const ASTNode* b) {
+    if (a->type != b->type || a->data_type != b->data_type || a->op != b->op ||
+        a->slot != b->slot || a->frame_size != b->frame_size ||
+        a->children_count != b->children_count) {
+        return false;
+    }
+    if ((a->value == NULL) != (b->value == NULL)) return false;
+    if (a->value && strcmp(a->value, b->value) != 0) return false;
+    if (a->type == AST_STRING && strcmp(a->literal.str_val, b->literal.str_val) != 0) return false;
+    if ((a->type == AST_NUMBER || a->type == AST_FLOAT) &&
+        a->literal.int_val != b->literal.int_val) {
+        return false;
+    }
+    for (int i = 0; i < a->children_count; i++) {
+        if (!same_ast(a->children[i], b->children[i])) return false;
+    }
+    return true;
+}
+
+int main(void) {
+    char path[64];
+    char cache_path[80];
+    snprintf(path, sizeof(path), "/tmp/azeng_startup_%ld.az", (long)getpid());
+    snprintf(cache_path, sizeof(cache_path), "%sc", path);
+
+    if (!write_script(path)) {
+        fprintf(stderr, "Tidak bisa menulis %s\n", path);
+        return 1;
+    }
+
+    // Cache ditulis sekali dari hasil parse
+    ASTNode* reference = load_cold(path);
+    SourceFile source;
+    load_source(path, &source);
+    bool stored = reference &&
+                  cache_store(cache_path, hash_source(source.data, source.length),
+                              source.length, reference);
+    size_t source_length = source.length;
+    unload_source(&source);
+
+    double cold = 1e9, cached = 1e9;
+    bool ok = stored;
+    for (int run = 0; run < RUNS && ok; run++) {
+        double start = now_seconds();
+        ASTNode* ast = load_cold(path);
+        double elapsed = now_seconds() - start;
+        if (elapsed < cold) cold = elapsed;
+        ok = ast != NULL;
+        free_ast(ast);
+
+        start = now_seconds();
+        ast = load_cached(path, cache_path);
+        elapsed = now_seconds() - start;
+        if (elapsed < cached) cached = elapsed;
+        ok = ok && ast && same_ast(reference, ast);
+        free_ast(ast);
+    }
+
+    free_ast(reference);
+    unlink(path);
+    unlink(cache_path);
+
+    if (!ok) {
+        fprintf(stderr, "AST dari cache tidak sama dengan hasil parse\n");
+        return 1;
+    }
+
+    printf("%-16s %8.1f KB\n", "source", source_length / 1024.0);
+    printf("%-16s %10.2f ms\n", "cold", cold * 1e3);
+    printf("%-16s %10.2f ms %6.1fx\n", "cached", cached * 1e3, cold / cached);
+    if (cached >= cold) {
+        fprintf(stderr, "Cache tidak lebih cepat dari parse\n");
+        return 1;
+    }
+    return 0;
+}
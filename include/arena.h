@@ -0,0 +1,25 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Bump allocator: alokasi hanya menggeser pointer, semua memori
+// dibebaskan sekaligus lewat free_arena.
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* head;
+} Arena;
+
+Arena* create_arena(void);
+void* arena_alloc(Arena* arena, size_t size);
+char* arena_strdup(Arena* arena, const char* str);
+char* arena_strndup(Arena* arena, const char* str, size_t length);
+void free_arena(Arena* arena);
+
+#endif
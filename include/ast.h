@@ -2,7 +2,9 @@
 #define AST_H
 
 #include "types.h"
+#include "arena.h"
 #include <stdlib.h>
+#include <stdbool.h>
 
 // Tipe node AST
 typedef enum {
@@ -35,20 +37,47 @@ typedef struct {
     DataType type;
 } Parameter;
 
+struct Builtin;
+
 // Struktur dasar untuk node AST
 typedef struct ASTNode {
     ASTNodeType type;
     char* value;
     DataType data_type;  // Tambahkan tipe data
+    BinaryOperator op;   // Operator AST_BINARY_OP; value hanya untuk diagnostik
     struct ASTNode** children;
     int children_count;
+    int children_capacity;
     Parameter* parameters;  // Untuk menyimpan parameter fungsi
     int param_count;
+    // Slot variabel di frame fungsinya (diisi resolver, -1 jika tidak ada).
+    // AST_FUNCTION: index fungsi di program. AST_CALL: index fungsi user
+    // yang dipanggil, -1 untuk builtin.
+    int slot;
+    int frame_size;      // Jumlah slot frame (AST_FUNCTION; AST_PROGRAM: yang terbesar)
+    Arena* arena;        // Pemilik seluruh memori AST (hanya untuk AST_PROGRAM)
+    // Nilai literal yang sudah didecode optimizer (AST_NUMBER, AST_FLOAT,
+    // AST_BOOLEAN, AST_STRING); value tetap teks aslinya untuk diagnostik.
+    // AST_CALL ke builtin: entry registry-nya, diisi parser atau cache.
+    union {
+        int int_val;
+        float float_val;
+        bool bool_val;
+        const char* str_val;    // Escape sudah diproses, memori di arena
+        const struct Builtin* builtin;
+    } literal;
 } ASTNode;
 
-// Fungsi-fungsi untuk membuat node AST
-ASTNode* create_ast_node(ASTNodeType type, const char* value);
-void add_child(ASTNode* parent, ASTNode* child);
+// Fungsi-fungsi untuk membuat node AST. Node, array children dan string
+// value dialokasikan dari arena; free_ast pada root melepas semuanya.
+ASTNode* create_ast_node(Arena* arena, ASTNodeType type, const char* value);
+// Sama seperti create_ast_node, value diambil dari potongan teks sepanjang length
+ASTNode* create_ast_node_n(Arena* arena, ASTNodeType type, const char* value, int length);
+void add_child(Arena* arena, ASTNode* parent, ASTNode* child);
 void free_ast(ASTNode* node);
+// Cari AST_FUNCTION bernama name di level atas program; NULL kalau tidak ada
+ASTNode* find_function(ASTNode* program, const char* name);
+// Jumlah parameter AST_FUNCTION (anak AST_PARAMETER di depan body)
+int function_param_count(const ASTNode* function);
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef BUILTIN_H
+#define BUILTIN_H
+
+#include "value.h"
+#include "http.h"
+#include "output.h"
+
+// Registry fungsi native. Nama dicari sekali saat parsing (atau saat AST
+// dimuat dari cache) dan Builtin-nya disimpan di node AST_CALL; OP_CALL
+// menyimpan id-nya. Builtin bawaan terdaftar otomatis; builtin lain
+// ditambah dengan register_builtin sebelum program di-parse, tanpa
+// menyentuh parser, compiler atau kedua engine.
+
+#define BUILTIN_CAPACITY 64
+#define BUILTIN_MAX_ARGS 8
+#define BUILTIN_CETAK 0     // id cetak; VM memakai OP_PRINT
+
+// Disediakan engine untuk builtin yang sedang dipanggil
+typedef struct BuiltinContext {
+    HttpClient* http;
+    Output* out;
+    void* engine;           // Interpreter atau VM
+    // Jalankan fungsi user ke-function dengan argc argumen, yang dipindah
+    // ke frame fungsi itu; argumen lebih dari jumlah parameter dibuang
+    Value (*call)(struct BuiltinContext* context, int function, Value* args, int argc);
+} BuiltinContext;
+
+// args milik engine dan dilepas setelah pemanggilan, kecuali argumen yang
+// dipinjam: salinan dangkal array variabel, jadi builtin boleh mengubah
+// elemennya tapi tidak ukurannya
+typedef Value (*BuiltinFn)(BuiltinContext* context, Value* args, int argc);
+
+typedef struct Builtin {
+    const char* name;       // Tidak disalin
+    BuiltinFn fn;
+    int min_args;           // Dicek parser
+    int max_args;           // Paling banyak BUILTIN_MAX_ARGS
+    unsigned borrowed;      // Bit i: argumen i array yang dipinjam, bukan disalin
+    unsigned callbacks;     // Bit i: argumen i nama fungsi user, diganti index-nya
+    int id;                 // Diisi register_builtin
+} Builtin;
+
+// Salin spec ke registry dan kembalikan entry-nya. Nama yang sudah ada
+// diganti dengan id yang sama, kecuali cetak yang tidak bisa diganti.
+// NULL kalau registry penuh, spec salah, atau namanya cetak.
+const Builtin* register_builtin(const Builtin* spec);
+// NULL kalau tidak ada
+const Builtin* find_builtin(const char* name);
+const Builtin* builtin_at(int id);
+
+#endif
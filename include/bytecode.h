@@ -0,0 +1,74 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdint.h>
+#include "value.h"
+
+// Operand B/C dengan bit ini menunjuk ke constant pool, bukan register
+#define RK_CONST 0x8000
+#define RK_MAX   0x7FFF
+
+// Instruksi register-based. R[x] = register, K[x] = constant,
+// RK[x] = register atau constant tergantung bit RK_CONST.
+typedef enum {
+    OP_LOADK,      // R[a] = K[sbx]
+    OP_LOADI,      // R[a] = sbx (integer langsung)
+    OP_MOVE,       // R[a] = R[b]
+    OP_ADD,        // R[a] = RK[b] + RK[c]
+    OP_SUB,        // R[a] = RK[b] - RK[c]
+    OP_MUL,        // R[a] = RK[b] * RK[c]
+    OP_DIV,        // R[a] = RK[b] / RK[c]
+    OP_LT,         // R[a] = RK[b] < RK[c]
+    OP_GT,         // R[a] = RK[b] > RK[c]
+    OP_JMP,        // ip += sbx
+    OP_JMPF,       // if !R[a]: ip += sbx; bukan boolean: error lalu lompat (n = 1 untuk ulang)
+    OP_PRINT,      // cetak RK[b]
+    OP_NEWARRAY,   // R[a] = array bertipe n (DataType) sebanyak RK[b]
+    OP_GETINDEX,   // R[a] = R[b][RK[c]]
+    OP_SETINDEX,   // R[a][RK[b]] = RK[c]
+    OP_CALL,       // R[a] = builtin id b(R[c] .. R[c+n-1]); array yang
+                   // dipinjam dikirim sebagai nomor register
+    OP_CALLFN,     // R[a] = fungsi b(R[c] .. R[c+n-1]); frame-nya mulai di R[c]
+    OP_TAILCALL,   // kembali fungsi b(R[c] .. R[c+n-1]) di frame ini
+    OP_RETURN,     // kembali dari fungsi dengan RK[b] (n = 1) atau void
+    OP_COUNT
+} OpCode;
+
+typedef struct {
+    uint8_t op;
+    uint8_t n;
+    uint16_t a;
+    union {
+        struct {
+            uint16_t b;
+            uint16_t c;
+        };
+        int32_t sbx;
+    };
+} Instruction;
+
+// Fungsi Azeng, dengan index yang sama seperti AST_FUNCTION di program.
+// Argumen ada di register 0..param_count-1 frame-nya, lalu slot variabel
+// lain dan register sementara.
+typedef struct {
+    const char* name;
+    int entry;              // Index instruksi pertama
+    int param_count;
+    int register_count;     // Ukuran frame
+} Function;
+
+typedef struct {
+    Instruction* code;
+    int count;
+    int capacity;
+    Value* constants;
+    int constant_count;
+    int constant_capacity;
+    Function* functions;
+    int function_count;
+    int main_function;      // -1 kalau program tidak punya main
+} Chunk;
+
+void free_chunk(Chunk* chunk);
+
+#endif
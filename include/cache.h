@@ -0,0 +1,35 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ast.h"
+
+// Cache AST hasil parse + optimizer + resolver (.azc). File berisi header,
+// array node dalam urutan preorder, lalu pool string; semuanya dibaca dengan
+// satu mmap. Cache hanya dipakai kalau hash dan panjang source cocok.
+
+// Hash isi source (FNV-1a per 8 byte)
+uint64_t hash_source(const char* data, size_t length);
+
+// Lokasi file cache: $AZENG_CACHE_DIR/<hash>.azc kalau diset, selain itu
+// di sebelah script (<path>c untuk .az). NULL untuk stdin tanpa cache dir.
+// Hasilnya di-malloc.
+char* cache_path_for(const char* script_path, uint64_t hash);
+
+// Bentuk .azc di memori (hasil malloc) dan kebalikannya, misalnya untuk
+// mengirim AST lewat pipe. cache_decode NULL kalau data rusak atau untuk
+// source lain; data boleh dibebaskan setelahnya.
+char* cache_encode(const ASTNode* program, uint64_t hash, size_t source_length,
+                   size_t* size);
+ASTNode* cache_decode(const char* data, size_t size, uint64_t hash, size_t source_length);
+
+// NULL kalau file tidak ada, rusak, atau untuk source lain
+ASTNode* cache_load(const char* cache_path, uint64_t hash, size_t source_length);
+// Tulis ke file sementara lalu rename, jadi pembaca tidak pernah melihat
+// file setengah jadi. false kalau gagal; kegagalan tidak fatal.
+bool cache_store(const char* cache_path, uint64_t hash, size_t source_length,
+                 const ASTNode* program);
+
+#endif
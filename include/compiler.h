@@ -0,0 +1,10 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "ast.h"
+#include "bytecode.h"
+
+// Kompilasi AST_PROGRAM menjadi bytecode untuk VM
+Chunk* compile_program(ASTNode* program);
+
+#endif
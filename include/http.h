@@ -0,0 +1,45 @@
+#ifndef HTTP_H
+#define HTTP_H
+
+#include <curl/curl.h>
+#include "value.h"
+
+// Batas handle idle yang disimpan untuk dipakai ulang
+#define HTTP_POOL_SIZE 8
+// Batas default transfer bersamaan untuk http_get_semua
+#define HTTP_MAX_CONCURRENT 8
+
+// Klien HTTP milik satu interpreter/VM. Handle easy dipakai ulang dan
+// cache DNS, koneksi serta sesi TLS dibagi lewat CURLSH, jadi panggilan
+// berulang ke host yang sama tidak membuka koneksi baru.
+typedef struct HttpClient {
+    CURLSH* share;
+    CURL* handles[HTTP_POOL_SIZE];
+    int handle_count;
+    CURLM* multi;        // Dibuat saat http_get_all pertama kali dipakai
+} HttpClient;
+
+HttpClient* create_http_client(void);
+void free_http_client(HttpClient* client);
+
+// Ambil handle dari pool (atau buat baru); kembalikan lewat http_release
+CURL* http_acquire(HttpClient* client);
+void http_release(HttpClient* client, CURL* curl);
+
+// Hasilnya TYPE_STRING berisi body, atau {0} kalau request gagal
+Value http_get(HttpClient* client, const char* url);
+Value http_post(HttpClient* client, const char* url, const char* data);
+// GET paralel untuk array string URL; hasilnya array string body dengan
+// urutan sama seperti input. max_concurrent <= 0 memakai HTTP_MAX_CONCURRENT
+Value http_get_all(HttpClient* client, const Value* urls, int max_concurrent);
+
+// Dipanggil sekali per baris body, tanpa '\n'/'\r\n' di ujungnya. line
+// tidak diakhiri '\0' dan hanya valid selama callback berjalan.
+typedef void (*HttpLineCallback)(const char* line, size_t length, void* context);
+
+// GET yang mengalirkan body baris per baris ke callback tanpa menampung
+// seluruh response; false kalau request gagal
+bool http_stream_lines(HttpClient* client, const char* url,
+                       HttpLineCallback callback, void* context);
+
+#endif
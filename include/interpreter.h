@@ -2,45 +2,67 @@
 #define INTERPRETER_H
 
 #include <stdbool.h>
+#include <signal.h>
 #include "types.h"
 #include "ast.h"
+#include "value.h"
+#include "http.h"
+#include "builtin.h"
 
-#define MAX_VARIABLES 100
-
-typedef struct {
-    DataType type;
-    union {
-        int int_val;
-        float float_val;
-        bool bool_val;
-        char* str_val;
-        int* int_array;     
-        float* float_array; 
-        char** str_array;   
-        bool* bool_array;    
-    } value;
-    int array_size;        
-} Value;
-
+// Satu slot frame; value disimpan inline dan dimiliki slot.
+// name hanya untuk pesan error
 typedef struct {
-    char* name;
-    Value* value;
+    const char* name;
+    Value value;
+    bool defined;
 } Variable;
 
+// Kapasitas stack slot semua frame: minimal INTERPRETER_STACK_SIZE, atau
+// INTERPRETER_FRAME_RESERVE slot per frame untuk max_depth yang besar.
+// Dialokasikan sekali dan tidak pernah dipindah, jadi pointer ke slot tetap
+// valid selama fungsi lain dipanggil.
+#define INTERPRETER_STACK_SIZE (1 << 16)
+#define INTERPRETER_FRAME_RESERVE 64
+// Stack C yang disisihkan per pemanggilan; rekursi biasa memakai sekitar
+// seperempatnya. Kalau max_depth butuh lebih dari batas stack proses,
+// program dijalankan di thread dengan stack sebesar itu.
+#define INTERPRETER_C_FRAME_RESERVE 4096
+
 typedef struct Interpreter {
-    Variable variables[MAX_VARIABLES];
-    int variable_count;
+    Variable* stack;     // Frame fungsi berurutan; frame main di awal.
+                         // Dialokasikan saat program pertama dijalankan.
+    int stack_capacity;
+    Variable* frame;     // Slot 0 frame fungsi yang sedang berjalan
+    int stack_top;       // Slot pertama setelah frame teratas
+    int stack_used;      // Batas atas slot yang pernah dipakai
+    int depth;           // Jumlah frame aktif
+    int max_depth;       // Default MAX_CALL_DEPTH; ubah sebelum interpret
+    bool returning;      // kembali sedang membongkar body fungsi
+    bool aborted;        // Error runtime fatal; semua frame dibongkar
+    Value return_value;
+    ASTNode* tail_function;  // Tail call yang menunggu di frame ini
+    int tail_argc;           // Argumennya di stack[stack_top..]
+    // Bukan 0: hentikan program (batas waktu --serve). Dicek di setiap
+    // iterasi ulang dan pemanggilan fungsi.
+    volatile sig_atomic_t* interrupt;
+    // Tiap pemanggilan juga memakai stack C. Budget-nya diukur dari
+    // max_depth, jadi batas ini hanya cadangan untuk ekspresi yang sangat
+    // bersarang dan tidak kena sebelum max_depth.
+    const char* c_stack_base;
+    size_t c_stack_budget;
+    HttpClient* http;    // Koneksi dipakai ulang antar panggilan http_*
+    bool owns_http;      // false kalau http milik pemanggil (mode --serve)
+    ASTNode* program;    // Untuk mencari fungsi callback
+    Output* out;         // Buffer cetak, di-flush saat free_interpreter
+    BuiltinContext builtins;
 } Interpreter;
 
 // Function declarations
 Interpreter* create_interpreter(void);
+// Menulis ke out_fd dan memakai http milik pemanggil, yang tidak dibebaskan
+// free_interpreter. Dipakai --serve supaya pool koneksi bertahan antar request.
+Interpreter* create_interpreter_shared(HttpClient* http, int out_fd);
 void free_interpreter(Interpreter* interpreter);
 void interpret(Interpreter* interpreter, ASTNode* node);
-Value* create_array(DataType type, int size);
-void free_value(Value* value);
-
-// HTTP functions
-Value evaluate_http_get(const char* url);
-Value evaluate_http_post(const char* url, const char* data);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "value.h"
+
+// Dokumen JSON hasil tahap 1: posisi semua karakter struktural ({ } [ ] : ,)
+// dan awal setiap nilai skalar, plus pasangan kurung penutupnya. Nilai
+// baru diurai (tahap 2) saat benar-benar diakses, jadi subtree yang tidak
+// disentuh tidak pernah dimaterialisasi.
+typedef struct JsonDocument {
+    int refcount;
+    char* text;             // Dimiliki dokumen, diakhiri '\0'
+    size_t length;
+    uint32_t* structurals;  // Offset ke text
+    uint32_t* matches;      // Untuk '{'/'[' index penutupnya, selain itu 0
+    int count;
+} JsonDocument;
+
+// Ambil alih text (hasil malloc) dan jalankan tahap 1. NULL kalau kurung
+// atau string tidak seimbang; text sudah dibebaskan dalam kasus itu.
+JsonDocument* json_parse(char* text, size_t length);
+void json_retain(JsonDocument* doc);
+void json_release(JsonDocument* doc);
+
+// Nilai root: object/array menjadi TYPE_JSON, skalar langsung diurai
+Value json_root(JsonDocument* doc);
+// Akses field object atau elemen array; TYPE_VOID kalau tidak ada
+Value json_get_field(const Value* json, const char* key);
+Value json_get_index(const Value* json, int index);
+// Jumlah field object atau elemen array
+int json_length(const Value* json);
+// Implementasi builtin. json_parse_value menyalin lalu melepas string di text
+// (text menjadi TYPE_VOID); json_access memakai key string untuk object
+// dan int untuk array.
+Value json_parse_value(Value* text);
+Value json_access(const Value* json, const Value* key);
+
+// Potongan teks mentah untuk TYPE_JSON (tanpa '\0' di ujungnya)
+const char* json_text(const Value* json, size_t* length);
+
+#endif
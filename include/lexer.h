@@ -3,15 +3,26 @@
 
 #include "token.h"
 
+// Lexer tidak menyalin source; buffer milik pemanggil dan harus tetap
+// hidup selama token dan lexer dipakai.
 typedef struct {
-    char* source;
+    const char* source;
+    int length;      // Panjang source, dihitung sekali oleh pemanggil
     int position;
     int line;
     int column;
 } Lexer;
 
-Lexer* create_lexer(const char* source);
-Token* get_next_token(Lexer* lexer);
+Lexer* create_lexer(const char* source, int length);
+// Mengembalikan TOKEN_EOF di akhir input atau saat karakter tidak dikenal
+Token get_next_token(Lexer* lexer);
+// Tokenisasi seluruh source ke satu array (diakhiri TOKEN_EOF).
+// Array di-malloc; pemanggil yang membebaskan.
+Token* tokenize(Lexer* lexer, int* count);
+// Pointer ke awal teks token di source (tidak diakhiri '\0')
+const char* token_text(const Lexer* lexer, const Token* token);
 void free_lexer(Lexer* lexer);
+// TokenType keyword untuk teks sepanjang length, atau TOKEN_IDENTIFIER
+TokenType lookup_keyword(const char* text, int length);
 
 #endif
@@ -0,0 +1,10 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "ast.h"
+
+// Decode semua literal ke node->literal dan lipat subtree AST_BINARY_OP
+// yang kedua operandnya konstan (misalnya 2 * 3 + x menjadi 6 + x).
+void optimize_program(ASTNode* program, Arena* arena);
+
+#endif
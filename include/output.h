@@ -0,0 +1,34 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define OUTPUT_BUFFER_SIZE (256 * 1024)
+
+// Buffer keluaran untuk cetak. Data ditulis langsung ke fd dengan write(2)
+// saat buffer penuh, saat output_flush, dan saat free_output. Dalam mode
+// unbuffered (default kalau fd adalah TTY) setiap cetak langsung di-flush.
+typedef struct Output {
+    int fd;
+    char* data;
+    size_t size;
+    size_t capacity;
+    bool unbuffered;
+} Output;
+
+Output* create_output(int fd);
+void free_output(Output* out);
+void output_flush(Output* out);
+void output_set_unbuffered(Output* out, bool unbuffered);
+
+void output_write(Output* out, const char* data, size_t length);
+void output_char(Output* out, char c);
+void output_str(Output* out, const char* str);
+void output_repeat(Output* out, char c, size_t count);
+void output_int(Output* out, int value);
+void output_float(Output* out, float value);
+// Akhir satu cetak; flush kalau unbuffered
+void output_end(Output* out);
+
+#endif
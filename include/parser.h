@@ -4,9 +4,15 @@
 #include "lexer.h"
 #include "ast.h"
 
+// Semua token diambil sekaligus ke array; parser hanya menggeser index
 typedef struct {
     Lexer* lexer;
-    Token* current_token;
+    Token* tokens;
+    int token_count;
+    int position;
+    Token* current_token;   // == &tokens[position]
+    Arena* arena;    // Memori AST, pindah ke root setelah parse()
+    int error_count; // Error yang tidak menghentikan parsing
 } Parser;
 
 Parser* create_parser(Lexer* lexer);
@@ -0,0 +1,14 @@
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include "ast.h"
+
+// Beri setiap AST_IDENTIFIER, AST_VARIABLE_DECL, AST_ASSIGNMENT, parameter
+// dan akses array nomor slot di frame fungsinya. Jumlah slot disimpan di
+// frame_size tiap AST_FUNCTION; yang terbesar dikembalikan dan disimpan di
+// program->frame_size.
+// Variabel juga harus pasti sudah diisi sebelum dibaca di setiap jalur;
+// pembacaan pertama yang melanggar disimpan di *undefined (NULL kalau tidak ada).
+int resolve_program(ASTNode* program, ASTNode** undefined);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdbool.h>
+
+// Mode daemon (--serve): satu proses menerima script lewat Unix domain
+// socket dan menjalankan setiap request di Interpreter/VM baru, tapi AST
+// hasil parse, bytecode dan pool koneksi HTTP dipakai ulang antar request.
+//
+// Protokol satu koneksi per request. Baris pertama berisi path absolut
+// script, atau "-" lalu source sampai EOF. Balasannya keluaran cetak dan
+// pesan error script, lalu koneksi ditutup.
+
+// Jalan sampai SIGINT/SIGTERM; 1 kalau socket tidak bisa dibuka.
+// max_depth berlaku untuk setiap request.
+int serve(const char* socket_path, bool tree_walk, bool use_cache, int max_depth);
+// Kirim script (path atau "-" untuk stdin) ke daemon dan salin balasannya
+// ke stdout
+int serve_client(const char* socket_path, const char* script_path);
+
+#endif
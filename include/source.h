@@ -0,0 +1,19 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Isi file script. File biasa di-mmap read-only dan tidak diakhiri '\0';
+// lexer hanya membaca sampai length. stdin dan pipe dibaca ke heap.
+typedef struct {
+    const char* data;
+    size_t length;
+    bool mapped;
+} SourceFile;
+
+// path "-" berarti stdin. false kalau file tidak bisa dibuka/dibaca.
+bool load_source(const char* path, SourceFile* source);
+void unload_source(SourceFile* source);
+
+#endif
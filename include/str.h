@@ -0,0 +1,42 @@
+#ifndef STR_H
+#define STR_H
+
+#include <stddef.h>
+
+// String ber-refcount untuk Value. Isinya biasanya disimpan tepat setelah
+// header dalam satu alokasi; buffer yang diambil alih (misalnya body HTTP)
+// dipakai langsung tanpa disalin. Menyalin string cukup menaikkan refcount,
+// jadi String yang dipakai bersama tidak boleh diubah. Hanya pemilik
+// tunggal (refcount 1) yang boleh menambah isi di tempat.
+typedef struct String {
+    int refcount;
+    size_t length;
+    size_t capacity;        // Byte yang muat di data, tanpa '\0'
+    char* data;             // Diakhiri '\0'; inline_data atau buffer sendiri
+    char inline_data[];
+} String;
+
+// Jumlah alokasi heap untuk isi Value sejak program mulai: String,
+// pertumbuhan buffernya, storage array dan dokumen JSON. Dibaca benchmark
+// lewat value_alloc_count.
+extern size_t value_heap_allocations;
+
+// Salin length byte dari data; refcount awal 1
+String* string_new(const char* data, size_t length);
+// String sepanjang length dengan isi belum diisi, untuk dirangkai pemanggil
+String* string_alloc(size_t length);
+// Ambil alih buffer hasil malloc yang sudah diakhiri '\0'
+String* string_adopt(char* buffer, size_t length);
+
+static inline String* string_retain(String* str) {
+    str->refcount++;
+    return str;
+}
+
+void string_release(String* str);
+// Tambahkan data di ujung String milik sendiri (refcount 1). Kapasitas
+// tumbuh dua kali lipat, jadi append berulang amortized O(1). Hasilnya
+// bisa berpindah alamat; NULL kalau kehabisan memori (str tetap valid).
+String* string_append(String* str, const char* data, size_t length);
+
+#endif
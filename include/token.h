@@ -55,14 +55,15 @@ typedef enum {
     TOKEN_ARRAY,      // array
 } TokenType;
 
+// Token tidak menyalin teks: start/length menunjuk ke buffer source lexer
 typedef struct {
     TokenType type;
-    char* value;
+    int start;
+    int length;
     int line;
     int column;
 } Token;
 
-Token* create_token(TokenType type, const char* value, int line, int column);
-void free_token(Token* token);
+Token create_token(TokenType type, int start, int length, int line, int column);
 
 #endif
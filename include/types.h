@@ -11,7 +11,26 @@ typedef enum {
     TYPE_ARRAY_FLOAT,
     TYPE_ARRAY_BOOL,
     TYPE_ARRAY_STRING,
-    TYPE_HTTP_RESPONSE
+    TYPE_HTTP_RESPONSE,
+    TYPE_JSON           // Object/array di dalam JsonDocument, diurai on-demand
 } DataType;
 
+#define TYPE_COUNT (TYPE_JSON + 1)
+
+// Batas default kedalaman pemanggilan fungsi user, sama untuk VM dan tree
+// walker; bisa diganti lewat field max_depth (--max-depth). Tail call
+// `kembali f(...)` memakai ulang frame dan tidak menambah kedalaman.
+#define MAX_CALL_DEPTH 1000
+
+// Operator biner, di-resolve parser dari token
+typedef enum {
+    BINOP_ADD,      // +
+    BINOP_SUB,      // -
+    BINOP_MUL,      // *
+    BINOP_DIV,      // /
+    BINOP_LT,       // <
+    BINOP_GT,       // >
+    BINOP_COUNT
+} BinaryOperator;
+
 #endif 
\ No newline at end of file
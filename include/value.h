@@ -0,0 +1,107 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+#include "output.h"
+#include "str.h"
+
+struct JsonDocument;
+
+// String sampai panjang ini disimpan langsung di Value tanpa alokasi heap
+#define VALUE_SMALL_MAX 15
+
+typedef struct {
+    DataType type;
+    // Array: jumlah elemen. String: panjang string pendek di value.small,
+    // atau -1 kalau isinya String ber-refcount di value.str
+    int array_size;
+    union {
+        int int_val;
+        float float_val;
+        bool bool_val;
+        String* str;
+        char small[VALUE_SMALL_MAX + 1];
+        int* int_array;
+        float* float_array;
+        String** str_array;     // NULL berarti string kosong
+        bool* bool_array;
+        struct {
+            struct JsonDocument* doc;
+            int index;          // Index struktural object/array
+        } json;
+    } value;
+} Value;
+
+// Jumlah alokasi heap untuk isi Value sejak program mulai (lihat
+// value_heap_allocations); variabel skalar dan string pendek tidak dihitung
+size_t value_alloc_count(void);
+
+static inline bool is_array_type(DataType type) {
+    return type >= TYPE_ARRAY_INT && type <= TYPE_ARRAY_STRING;
+}
+
+static inline bool is_string_type(DataType type) {
+    return type == TYPE_STRING || type == TYPE_HTTP_RESPONSE;
+}
+
+// Isi dan panjang value string (TYPE_STRING/TYPE_HTTP_RESPONSE)
+static inline const char* value_cstr(const Value* value) {
+    return value->array_size >= 0 ? value->value.small : value->value.str->data;
+}
+
+static inline size_t value_strlen(const Value* value) {
+    return value->array_size >= 0 ? (size_t)value->array_size : value->value.str->length;
+}
+
+// Value string baru berisi salinan data
+Value make_string(const char* data, size_t length);
+// Value string dari String yang sudah ada; referensi str diambil alih
+Value string_value(String* str);
+// Value string yang mengambil alih buffer malloc berakhiran '\0'
+Value adopt_string(char* buffer, size_t length);
+// Referensi String untuk isi value string (string pendek dialokasikan)
+String* value_to_string(const Value* value);
+// target = target + right untuk dua value string. Kalau String target
+// hanya dimiliki target, isinya ditambah di tempat tanpa menyalin ulang.
+void append_string(Value* target, const Value* right);
+
+// Array inline (tanpa box); tipe bukan array menghasilkan TYPE_VOID
+Value make_array(DataType type, int size);
+// Elemen ke-index sebagai Value inline; string hanya menaikkan refcount.
+// Index tidak dicek; gunakan array_get untuk versi yang aman
+Value array_load(const Value* arr, int index);
+// Versi array_load yang mengecek index; false kalau di luar batas
+bool array_get(const Value* arr, int index, Value* out);
+bool array_set(Value* arr, int index, const Value* value);
+
+// Operasi massal untuk builtin array_*, langsung di atas buffer elemen.
+// Kalau gagal pesan error ditulis ke stderr dan hasilnya false/TYPE_VOID.
+// array_copy menyalin min(ukuran) elemen pertama; jumlah, min, maks dan
+// dot hanya untuk array int dan float.
+bool array_fill(Value* arr, const Value* value);
+bool array_copy(Value* dst, const Value* src);
+Value array_sum(const Value* arr);
+Value array_min(const Value* arr);
+Value array_max(const Value* arr);
+Value array_dot(const Value* left, const Value* right);
+
+// Bebaskan isi value (string/array) tanpa membebaskan struct-nya
+void release_value(Value* value);
+// Salinan penuh: array ikut diduplikasi, string dan JSON cukup berbagi
+Value copy_value(const Value* value);
+
+// Operator biner lewat tabel dispatch tipe x operator. Hanya pasangan
+// int/int, float/float dan string/string yang didukung; selain itu
+// hasilnya {0}. String hasil + dialokasikan baru.
+Value binary_operation(BinaryOperator op, const Value* left, const Value* right);
+
+// Proses escape sequence (\n, \t, \\) pada string literal
+char* process_string(const char* input);
+// Implementasi cetak untuk semua tipe value, ditulis ke buffer out
+void print_value(Output* out, Value value);
+// cetak untuk teks string; dipakai juga untuk literal tanpa membuat Value
+void print_text(Output* out, const char* text, size_t length);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef VM_H
+#define VM_H
+
+#include <signal.h>
+#include "bytecode.h"
+#include "builtin.h"
+#include "http.h"
+
+// Kapasitas stack register semua frame: minimal VM_STACK_SIZE, atau
+// VM_FRAME_RESERVE register per frame untuk max_depth yang besar.
+// Dialokasikan sekali dan tidak pernah dipindah, jadi pointer register tetap
+// valid selama pemanggilan; halaman yang belum disentuh tidak memakai memori.
+#define VM_STACK_SIZE (1 << 16)
+#define VM_FRAME_RESERVE 64
+
+// Frame pemanggil yang disimpan OP_CALLFN
+typedef struct {
+    const Instruction* return_ip;
+    Value* base;            // Register 0 frame pemanggil
+    int dst;                // Register hasil di frame pemanggil
+    int register_count;     // Ukuran frame yang dipanggil
+} CallFrame;
+
+typedef struct VM {
+    Value* registers;    // Frame fungsi berurutan; frame main di awal
+    int register_count;  // Batas atas register yang pernah dipakai
+    size_t register_capacity;
+    CallFrame* frames;   // max_depth frame, dialokasikan saat vm_run pertama
+    int frame_count;
+    int max_depth;       // Default MAX_CALL_DEPTH; ubah sebelum vm_run
+    bool aborted;        // Error runtime fatal; semua frame dibongkar
+    // Bukan 0: hentikan program (batas waktu --serve). Dicek di lompatan
+    // mundur loop dan setiap pemanggilan fungsi.
+    volatile sig_atomic_t* interrupt;
+    HttpClient* http;
+    bool owns_http;      // false kalau http milik pemanggil (mode --serve)
+    Chunk* chunk;        // Chunk yang sedang dijalankan, untuk callback
+    Output* out;         // Buffer cetak, di-flush saat free_vm
+    BuiltinContext builtins;
+    Value* native_top;   // Di atas argumen builtin yang sedang berjalan
+} VM;
+
+VM* create_vm(void);
+// Cetak ke out_fd dan pakai http milik pemanggil (tidak dibebaskan free_vm)
+VM* create_vm_shared(HttpClient* http, int out_fd);
+void free_vm(VM* vm);
+void vm_run(VM* vm, Chunk* chunk);
+
+#endif
@@ -0,0 +1,76 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 8
+
+static ArenaBlock* new_block(size_t size) {
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+Arena* create_arena(void) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    if (!arena) return NULL;
+    arena->head = NULL;
+    return arena;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    ArenaBlock* block = arena->head;
+    if (!block || block->used + size > block->size) {
+        // Alokasi besar dapat blok sendiri supaya blok aktif tidak terbuang
+        if (size > ARENA_BLOCK_SIZE / 4) {
+            ArenaBlock* big = new_block(size);
+            if (!big) return NULL;
+            big->used = size;
+            if (block) {
+                big->next = block->next;
+                block->next = big;
+            } else {
+                arena->head = big;
+            }
+            return big->data;
+        }
+
+        block = new_block(ARENA_BLOCK_SIZE);
+        if (!block) return NULL;
+        block->next = arena->head;
+        arena->head = block;
+    }
+
+    void* ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+char* arena_strndup(Arena* arena, const char* str, size_t length) {
+    char* copy = arena_alloc(arena, length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+char* arena_strdup(Arena* arena, const char* str) {
+    return arena_strndup(arena, str, strlen(str));
+}
+
+void free_arena(Arena* arena) {
+    if (!arena) return;
+
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
@@ -1,45 +1,65 @@
 #include "ast.h"
 #include <string.h>
 
-ASTNode* create_ast_node(ASTNodeType type, const char* value) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* create_ast_node_n(Arena* arena, ASTNodeType type, const char* value, int length) {
+    ASTNode* node = (ASTNode*)arena_alloc(arena, sizeof(ASTNode));
     if (!node) return NULL;
 
+    memset(node, 0, sizeof(ASTNode));
     node->type = type;
-    node->children = NULL;
-    node->children_count = 0;
+    node->slot = -1;
 
     if (value) {
-        node->value = strdup(value);
-    } else {
-        node->value = NULL;
+        node->value = arena_strndup(arena, value, length);
     }
 
     return node;
 }
 
-void add_child(ASTNode* parent, ASTNode* child) {
+ASTNode* create_ast_node(Arena* arena, ASTNodeType type, const char* value) {
+    return create_ast_node_n(arena, type, value, value ? (int)strlen(value) : 0);
+}
+
+void add_child(Arena* arena, ASTNode* parent, ASTNode* child) {
     if (!parent || !child) return;
 
-    parent->children_count++;
-    parent->children = (ASTNode**)realloc(
-        parent->children, 
-        parent->children_count * sizeof(ASTNode*)
-    );
-    
-    if (parent->children) {
-        parent->children[parent->children_count - 1] = child;
+    // Kapasitas digandakan supaya total salinan tetap linear
+    if (parent->children_count == parent->children_capacity) {
+        int capacity = parent->children_capacity ? parent->children_capacity * 2 : 4;
+        ASTNode** children = (ASTNode**)arena_alloc(arena, capacity * sizeof(ASTNode*));
+        if (!children) return;
+        if (parent->children_count > 0) {
+            memcpy(children, parent->children, parent->children_count * sizeof(ASTNode*));
+        }
+        parent->children = children;
+        parent->children_capacity = capacity;
     }
+
+    parent->children[parent->children_count++] = child;
 }
 
-void free_ast(ASTNode* node) {
-    if (!node) return;
+ASTNode* find_function(ASTNode* program, const char* name) {
+    for (int i = 0; i < program->children_count; i++) {
+        ASTNode* child = program->children[i];
+        if (child->type == AST_FUNCTION && strcmp(child->value, name) == 0) {
+            return child;
+        }
+    }
+    return NULL;
+}
 
-    for (int i = 0; i < node->children_count; i++) {
-        free_ast(node->children[i]);
+int function_param_count(const ASTNode* function) {
+    int count = 0;
+    while (count < function->children_count &&
+           function->children[count]->type == AST_PARAMETER) {
+        count++;
     }
+    return count;
+}
 
-    if (node->children) free(node->children);
-    if (node->value) free(node->value);
-    free(node);
-} 
\ No newline at end of file
+void free_ast(ASTNode* node) {
+    // Subtree tidak perlu dibebaskan satu per satu; cukup arena di root
+    if (node && node->arena) {
+        free_arena(node->arena);
+    }
+}
@@ -0,0 +1,270 @@
+#include "builtin.h"
+#include "json.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BUILTIN_TABLE_SIZE (BUILTIN_CAPACITY * 2)   // Pangkat dua
+
+static Builtin registry[BUILTIN_CAPACITY];
+static int registry_count = 0;
+static int table[BUILTIN_TABLE_SIZE];               // id + 1, 0 berarti kosong
+
+static Value void_result(void) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    return result;
+}
+
+static Value builtin_cetak(BuiltinContext* context, Value* args, int argc) {
+    (void)argc;
+    print_value(context->out, args[0]);
+    return void_result();
+}
+
+static Value builtin_http_get(BuiltinContext* context, Value* args, int argc) {
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_STRING) {
+        result = http_get(context->http, value_cstr(&args[0]));
+    }
+    return result;
+}
+
+static Value builtin_http_post(BuiltinContext* context, Value* args, int argc) {
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_STRING && args[1].type == TYPE_STRING) {
+        result = http_post(context->http, value_cstr(&args[0]), value_cstr(&args[1]));
+    }
+    return result;
+}
+
+// Argumen kedua opsional: batas request bersamaan
+static Value builtin_http_get_semua(BuiltinContext* context, Value* args, int argc) {
+    int limit = argc >= 2 && args[1].type == TYPE_INT ? args[1].value.int_val : 0;
+    return http_get_all(context->http, &args[0], limit);
+}
+
+typedef struct {
+    BuiltinContext* context;
+    int function;
+} StreamTarget;
+
+// Tiap baris dikirim sebagai argumen pertama fungsi callback
+static void stream_line(const char* line, size_t length, void* data) {
+    StreamTarget* target = data;
+    Value arg = make_string(line, length);
+    Value result = target->context->call(target->context, target->function, &arg, 1);
+    release_value(&result);
+}
+
+static Value builtin_http_get_alir(BuiltinContext* context, Value* args, int argc) {
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_STRING && args[1].type == TYPE_INT) {
+        StreamTarget target = { context, args[1].value.int_val };
+        result.type = TYPE_BOOLEAN;
+        result.value.bool_val = http_stream_lines(context->http, value_cstr(&args[0]),
+                                                  stream_line, &target);
+    }
+    return result;
+}
+
+// Argumen milik engine, jadi boleh dilepas di sini
+static Value builtin_json_urai(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return json_parse_value(&args[0]);
+}
+
+static Value builtin_json_ambil(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return json_access(&args[0], &args[1]);
+}
+
+static Value builtin_json_panjang(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    result.type = TYPE_INT;
+    result.value.int_val = json_length(&args[0]);
+    return result;
+}
+
+static Value builtin_tambah(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_INT && args[1].type == TYPE_INT) {
+        result.type = TYPE_INT;
+        result.value.int_val = args[0].value.int_val + args[1].value.int_val;
+    }
+    return result;
+}
+
+static Value builtin_bagi(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_FLOAT && args[1].type == TYPE_FLOAT) {
+        result.type = TYPE_FLOAT;
+        result.value.float_val = args[0].value.float_val / args[1].value.float_val;
+    }
+    return result;
+}
+
+static Value builtin_lebih_besar(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_INT && args[1].type == TYPE_INT) {
+        result.type = TYPE_BOOLEAN;
+        result.value.bool_val = args[0].value.int_val > args[1].value.int_val;
+    }
+    return result;
+}
+
+static Value builtin_gabung(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    Value result = {0};
+    if (args[0].type == TYPE_STRING && args[1].type == TYPE_STRING) {
+        result = binary_operation(BINOP_ADD, &args[0], &args[1]);
+    }
+    return result;
+}
+
+static Value builtin_array_isi(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    array_fill(&args[0], &args[1]);
+    return void_result();
+}
+
+static Value builtin_array_salin(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    array_copy(&args[0], &args[1]);
+    return void_result();
+}
+
+static Value builtin_array_jumlah(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return array_sum(&args[0]);
+}
+
+static Value builtin_array_min(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return array_min(&args[0]);
+}
+
+static Value builtin_array_maks(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return array_max(&args[0]);
+}
+
+static Value builtin_array_dot(BuiltinContext* context, Value* args, int argc) {
+    (void)context;
+    (void)argc;
+    return array_dot(&args[0], &args[1]);
+}
+
+// cetak harus pertama supaya id-nya BUILTIN_CETAK
+static const Builtin defaults[] = {
+    { .name = "cetak", .fn = builtin_cetak, .min_args = 1, .max_args = 1 },
+    { .name = "http_get", .fn = builtin_http_get, .min_args = 1, .max_args = 1 },
+    { .name = "http_post", .fn = builtin_http_post, .min_args = 2, .max_args = 2 },
+    { .name = "http_get_semua", .fn = builtin_http_get_semua, .min_args = 1, .max_args = 2 },
+    { .name = "http_get_alir", .fn = builtin_http_get_alir, .min_args = 2, .max_args = 2,
+      .callbacks = 1u << 1 },
+    { .name = "json_urai", .fn = builtin_json_urai, .min_args = 1, .max_args = 1 },
+    { .name = "json_ambil", .fn = builtin_json_ambil, .min_args = 2, .max_args = 2 },
+    { .name = "json_panjang", .fn = builtin_json_panjang, .min_args = 1, .max_args = 1 },
+    { .name = "tambah", .fn = builtin_tambah, .min_args = 2, .max_args = 2 },
+    { .name = "bagi", .fn = builtin_bagi, .min_args = 2, .max_args = 2 },
+    { .name = "lebih_besar", .fn = builtin_lebih_besar, .min_args = 2, .max_args = 2 },
+    { .name = "gabung", .fn = builtin_gabung, .min_args = 2, .max_args = 2 },
+    { .name = "array_isi", .fn = builtin_array_isi, .min_args = 2, .max_args = 2,
+      .borrowed = 1u << 0 },
+    { .name = "array_salin", .fn = builtin_array_salin, .min_args = 2, .max_args = 2,
+      .borrowed = 1u << 0 | 1u << 1 },
+    { .name = "array_jumlah", .fn = builtin_array_jumlah, .min_args = 1, .max_args = 1,
+      .borrowed = 1u << 0 },
+    { .name = "array_min", .fn = builtin_array_min, .min_args = 1, .max_args = 1,
+      .borrowed = 1u << 0 },
+    { .name = "array_maks", .fn = builtin_array_maks, .min_args = 1, .max_args = 1,
+      .borrowed = 1u << 0 },
+    { .name = "array_dot", .fn = builtin_array_dot, .min_args = 2, .max_args = 2,
+      .borrowed = 1u << 0 | 1u << 1 },
+};
+
+static unsigned hash_name(const char* name) {
+    unsigned hash = 2166136261u;
+    for (; *name; name++) {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+// Index tabel untuk name: entry-nya, atau slot kosong tempat menambahkannya
+static unsigned table_index(const char* name) {
+    unsigned i = hash_name(name) & (BUILTIN_TABLE_SIZE - 1);
+    while (table[i] && strcmp(registry[table[i] - 1].name, name) != 0) {
+        i = (i + 1) & (BUILTIN_TABLE_SIZE - 1);
+    }
+    return i;
+}
+
+static const Builtin* add_builtin(const Builtin* spec) {
+    if (!spec->name || !spec->fn || spec->min_args < 0 ||
+        spec->max_args < spec->min_args || spec->max_args > BUILTIN_MAX_ARGS) {
+        fprintf(stderr, "Error: Builtin '%s' tidak valid\n", spec->name ? spec->name : "");
+        return NULL;
+    }
+
+    unsigned i = table_index(spec->name);
+    int id = table[i] ? table[i] - 1 : registry_count;
+    if (id == BUILTIN_CAPACITY) {
+        fprintf(stderr, "Error: Terlalu banyak builtin\n");
+        return NULL;
+    }
+    if (!table[i]) {
+        table[i] = ++registry_count;
+    }
+    registry[id] = *spec;
+    registry[id].id = id;
+    return &registry[id];
+}
+
+static void register_defaults(void) {
+    if (registry_count > 0) return;
+    for (size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++) {
+        add_builtin(&defaults[i]);
+    }
+}
+
+const Builtin* register_builtin(const Builtin* spec) {
+    register_defaults();
+    // cetak dijalankan langsung oleh OP_PRINT dan interpreter, jadi
+    // penggantinya tidak akan pernah dipanggil
+    const Builtin* existing = spec->name ? find_builtin(spec->name) : NULL;
+    if (existing && existing->id == BUILTIN_CETAK) {
+        fprintf(stderr, "Error: Builtin '%s' tidak bisa diganti\n", spec->name);
+        return NULL;
+    }
+    return add_builtin(spec);
+}
+
+const Builtin* find_builtin(const char* name) {
+    register_defaults();
+    unsigned i = table_index(name);
+    return table[i] ? &registry[table[i] - 1] : NULL;
+}
+
+const Builtin* builtin_at(int id) {
+    return id >= 0 && id < registry_count ? &registry[id] : NULL;
+}
@@ -0,0 +1,579 @@
+#include "cache.h"
+#include "builtin.h"
+#include "bytecode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Naikkan kalau bentuk AST, optimizer atau resolver berubah
+#define CACHE_VERSION 4
+#define CACHE_NO_STRING 0xFFFFFFFFu
+
+static const char cache_magic[4] = {'A', 'Z', 'C', '1'};
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t source_hash;
+    uint64_t source_length;
+    uint32_t node_size;      // sizeof(CacheNode), menolak file dari build lain
+    uint32_t node_count;
+    uint32_t string_bytes;
+    uint32_t reserved;
+    uint64_t payload_hash;   // Hash node + pool string, mendeteksi file rusak
+} CacheHeader;
+
+// Satu node dalam urutan preorder; anak-anaknya langsung menyusul
+typedef struct {
+    uint8_t type;
+    uint8_t data_type;
+    uint8_t op;
+    uint8_t reserved;
+    int32_t slot;
+    int32_t frame_size;
+    uint32_t children_count;
+    uint32_t value;          // Offset ke pool string
+    uint32_t literal;        // Bit int/float/bool, atau offset string
+} CacheNode;
+
+uint64_t hash_source(const char* data, size_t length) {
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i = 0;
+
+    // Per 8 byte; xorshift supaya bit atas ikut tercampur ke bawah
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; i++) {
+        hash = (hash ^ (unsigned char)data[i]) * prime;
+    }
+    return hash;
+}
+
+char* cache_path_for(const char* script_path, uint64_t hash) {
+    const char* dir = getenv("AZENG_CACHE_DIR");
+    char* path;
+
+    if (dir && dir[0]) {
+        size_t size = strlen(dir) + 32;
+        path = malloc(size);
+        if (path) snprintf(path, size, "%s/%016llx.azc", dir, (unsigned long long)hash);
+        return path;
+    }
+
+    if (strcmp(script_path, "-") == 0) return NULL;
+
+    // foo.az -> foo.azc, nama lain -> nama.azc
+    size_t length = strlen(script_path);
+    bool az = length >= 3 && strcmp(script_path + length - 3, ".az") == 0;
+    path = malloc(length + 5);
+    if (path) {
+        memcpy(path, script_path, length);
+        strcpy(path + length, az ? "c" : ".azc");
+    }
+    return path;
+}
+
+static uint64_t payload_hash(const char* nodes, size_t node_bytes,
+                             const char* strings, size_t string_bytes) {
+    return hash_source(nodes, node_bytes) * 31 + hash_source(strings, string_bytes);
+}
+
+/* ---- Menulis ---- */
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} Buffer;
+
+static void* buffer_reserve(Buffer* buffer, size_t length) {
+    if (buffer->failed) return NULL;
+    if (buffer->size + length > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < buffer->size + length) capacity *= 2;
+        char* grown = realloc(buffer->data, capacity);
+        if (!grown) {
+            buffer->failed = true;
+            return NULL;
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+    void* ptr = buffer->data + buffer->size;
+    buffer->size += length;
+    return ptr;
+}
+
+// Pool string dengan interning: nama variabel dan operator yang berulang
+// hanya disimpan sekali
+typedef struct {
+    Buffer buffer;
+    uint32_t* slots;         // Offset + 1, 0 berarti kosong
+    size_t capacity;
+    size_t count;
+} StringPool;
+
+static uint64_t hash_string(const char* str, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)str[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool pool_grow(StringPool* pool) {
+    size_t capacity = pool->capacity ? pool->capacity * 2 : 1024;
+    uint32_t* slots = calloc(capacity, sizeof(uint32_t));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < pool->capacity; i++) {
+        if (!pool->slots[i]) continue;
+        const char* str = pool->buffer.data + pool->slots[i] - 1;
+        size_t j = hash_string(str, strlen(str)) & (capacity - 1);
+        while (slots[j]) j = (j + 1) & (capacity - 1);
+        slots[j] = pool->slots[i];
+    }
+    free(pool->slots);
+    pool->slots = slots;
+    pool->capacity = capacity;
+    return true;
+}
+
+static uint32_t add_string(StringPool* pool, const char* str) {
+    if (!str) return CACHE_NO_STRING;
+    if (pool->count * 2 >= pool->capacity && !pool_grow(pool)) {
+        pool->buffer.failed = true;
+        return CACHE_NO_STRING;
+    }
+
+    size_t length = strlen(str) + 1;
+    size_t i = hash_string(str, length - 1) & (pool->capacity - 1);
+    while (pool->slots[i]) {
+        const char* existing = pool->buffer.data + pool->slots[i] - 1;
+        if (memcmp(existing, str, length) == 0) return pool->slots[i] - 1;
+        i = (i + 1) & (pool->capacity - 1);
+    }
+
+    size_t offset = pool->buffer.size;
+    char* dest = buffer_reserve(&pool->buffer, length);
+    if (!dest || offset >= CACHE_NO_STRING - 1) {
+        pool->buffer.failed = true;
+        return CACHE_NO_STRING;
+    }
+    memcpy(dest, str, length);
+    pool->slots[i] = (uint32_t)offset + 1;
+    pool->count++;
+    return (uint32_t)offset;
+}
+
+static uint32_t encode_literal(const ASTNode* node, StringPool* strings) {
+    uint32_t bits = 0;
+    switch (node->type) {
+        case AST_NUMBER:
+            bits = (uint32_t)node->literal.int_val;
+            break;
+        case AST_FLOAT:
+            memcpy(&bits, &node->literal.float_val, sizeof(bits));
+            break;
+        case AST_BOOLEAN:
+            bits = node->literal.bool_val;
+            break;
+        case AST_STRING:
+            bits = add_string(strings, node->literal.str_val);
+            break;
+        default:
+            break;
+    }
+    return bits;
+}
+
+static void write_node(const ASTNode* node, Buffer* nodes, StringPool* strings) {
+    if (!buffer_reserve(nodes, sizeof(CacheNode))) return;
+    size_t index = nodes->size - sizeof(CacheNode);
+
+    CacheNode entry = {
+        .type = (uint8_t)node->type,
+        .data_type = (uint8_t)node->data_type,
+        .op = (uint8_t)node->op,
+        .slot = node->slot,
+        .frame_size = node->frame_size,
+        .children_count = (uint32_t)node->children_count,
+    };
+    entry.value = add_string(strings, node->value);
+    entry.literal = encode_literal(node, strings);
+    // Buffer node bisa pindah saat tumbuh; tulis lewat offset
+    memcpy(nodes->data + index, &entry, sizeof(entry));
+
+    for (int i = 0; i < node->children_count; i++) {
+        write_node(node->children[i], nodes, strings);
+    }
+}
+
+static bool write_all(int fd, const void* data, size_t length) {
+    const char* p = data;
+    while (length > 0) {
+        ssize_t count = write(fd, p, length);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+
+char* cache_encode(const ASTNode* program, uint64_t hash, size_t source_length,
+                   size_t* size) {
+    Buffer nodes = {0};
+    StringPool strings = {0};
+    write_node(program, &nodes, &strings);
+
+    char* data = NULL;
+    if (!nodes.failed && !strings.buffer.failed &&
+        nodes.size / sizeof(CacheNode) < UINT32_MAX) {
+        CacheHeader header = {
+            .version = CACHE_VERSION,
+            .source_hash = hash,
+            .source_length = source_length,
+            .node_size = sizeof(CacheNode),
+            .node_count = (uint32_t)(nodes.size / sizeof(CacheNode)),
+            .string_bytes = (uint32_t)strings.buffer.size,
+            .payload_hash = payload_hash(nodes.data, nodes.size,
+                                         strings.buffer.data, strings.buffer.size),
+        };
+        memcpy(header.magic, cache_magic, sizeof(cache_magic));
+
+        *size = sizeof(header) + nodes.size + strings.buffer.size;
+        data = malloc(*size);
+        if (data) {
+            memcpy(data, &header, sizeof(header));
+            memcpy(data + sizeof(header), nodes.data, nodes.size);
+            if (strings.buffer.size > 0) {
+                memcpy(data + sizeof(header) + nodes.size, strings.buffer.data,
+                       strings.buffer.size);
+            }
+        }
+    }
+
+    free(nodes.data);
+    free(strings.buffer.data);
+    free(strings.slots);
+    return data;
+}
+
+bool cache_store(const char* cache_path, uint64_t hash, size_t source_length,
+                 const ASTNode* program) {
+    size_t size;
+    char* data = cache_encode(program, hash, source_length, &size);
+    if (!data) return false;
+
+    size_t tmp_size = strlen(cache_path) + 32;
+    char* tmp_path = malloc(tmp_size);
+    bool ok = tmp_path != NULL;
+    if (ok) {
+        // mkstemp membuat file baru dengan O_EXCL, jadi tulisan tidak bisa
+        // dibelokkan lewat file atau symlink yang sudah ada di path itu
+        snprintf(tmp_path, tmp_size, "%s.XXXXXX", cache_path);
+        int fd = mkstemp(tmp_path);
+        ok = fd >= 0;
+        if (ok) {
+            ok = fchmod(fd, 0644) == 0 && write_all(fd, data, size);
+            ok = close(fd) == 0 && ok;
+            ok = ok && rename(tmp_path, cache_path) == 0;
+            if (!ok) unlink(tmp_path);
+        }
+        free(tmp_path);
+    }
+
+    free(data);
+    return ok;
+}
+
+/* ---- Membaca ---- */
+
+typedef struct {
+    const CacheNode* records;
+    uint32_t node_count;
+    uint32_t next;           // Record berikutnya yang belum dipakai
+    ASTNode* nodes;
+    ASTNode** children;      // Semua array children, berurutan
+    uint32_t children_used;
+    char* strings;           // Pool string yang sudah disalin ke arena
+    uint32_t string_bytes;
+    uint32_t function_count; // Anak root
+    const ASTNode* function; // AST_FUNCTION yang sedang dimuat
+} Loader;
+
+static bool load_string(const Loader* loader, uint32_t offset, char** out) {
+    if (offset == CACHE_NO_STRING) {
+        *out = NULL;
+        return true;
+    }
+    if (offset >= loader->string_bytes) return false;
+    *out = loader->strings + offset;
+    return true;
+}
+
+// Index fungsi dan slot dipakai kedua engine tanpa dicek lagi, dan hash
+// payload bisa dihitung ulang siapa saja; file yang rusak atau dibuat-buat
+// tidak boleh menghasilkan akses di luar program, frame atau argumen builtin
+static bool check_indices(Loader* loader, const ASTNode* node, uint32_t index,
+                          uint32_t children_count) {
+    switch (node->type) {
+        case AST_PROGRAM:
+            loader->function_count = children_count;
+            return index == 0;
+        case AST_FUNCTION:
+            // Slot tidak bisa lebih banyak dari jumlah node
+            return !loader->function && node->frame_size >= 0 &&
+                   (uint32_t)node->frame_size <= loader->node_count;
+        case AST_IDENTIFIER:
+        case AST_VARIABLE_DECL:
+        case AST_ASSIGNMENT:
+        case AST_ARRAY_ACCESS:
+        case AST_ARRAY_ASSIGN:
+        case AST_PARAMETER:
+            return loader->function && node->slot >= 0 &&
+                   node->slot < loader->function->frame_size;
+        case AST_CALL:
+            if (node->slot >= 0) return (uint32_t)node->slot < loader->function_count;
+            return children_count >= (uint32_t)node->literal.builtin->min_args &&
+                   children_count <= (uint32_t)node->literal.builtin->max_args;
+        default:
+            return true;
+    }
+}
+
+// Jumlah dan jenis anak seperti yang dibuat parser. Kedua engine langsung
+// memakai children[0], children[1] atau anak terakhir tanpa mengecek.
+static bool check_children(const ASTNode* node) {
+    int count = node->children_count;
+    switch (node->type) {
+        case AST_FUNCTION:
+            // Parameter lalu body
+            if (count < 1 || node->children[count - 1]->type != AST_BLOCK) return false;
+            for (int i = 0; i < count - 1; i++) {
+                if (node->children[i]->type != AST_PARAMETER) return false;
+            }
+            return true;
+        case AST_IF:
+        case AST_WHILE:
+            return count == 2 && node->children[1]->type == AST_BLOCK;
+        case AST_BINARY_OP:
+        case AST_ARRAY_ASSIGN:
+            return count == 2;
+        case AST_ARRAY_ACCESS:
+        case AST_VARIABLE_DECL:
+        case AST_ASSIGNMENT:
+        case AST_ARRAY_DECL:
+            return count == 1;
+        case AST_RETURN:
+            return count <= 1;
+        case AST_CALL:
+            // Argumen dievaluasi ke register berurutan
+            return count <= RK_MAX;
+        case AST_PROGRAM:
+        case AST_BLOCK:
+        case AST_ARRAY_LITERAL:
+            return true;
+        default:
+            return count == 0;
+    }
+}
+
+// Argumen callback sudah menjadi index fungsi saat linking
+static bool check_callbacks(const Loader* loader, const ASTNode* call) {
+    unsigned callbacks = call->literal.builtin->callbacks;
+    for (int i = 0; i < call->children_count; i++) {
+        if (!(callbacks & (1u << i))) continue;
+        const ASTNode* arg = call->children[i];
+        if (arg->type != AST_NUMBER || arg->literal.int_val < 0 ||
+            (uint32_t)arg->literal.int_val >= loader->function_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ASTNode* load_node(Loader* loader) {
+    if (loader->next >= loader->node_count) return NULL;
+
+    uint32_t index = loader->next;
+    const CacheNode* record = &loader->records[index];
+    ASTNode* node = &loader->nodes[index];
+    loader->next++;
+
+    if (record->type > AST_ARRAY_LITERAL || record->data_type >= TYPE_COUNT ||
+        record->op >= BINOP_COUNT) {
+        return NULL;
+    }
+
+    node->type = (ASTNodeType)record->type;
+    node->data_type = (DataType)record->data_type;
+    node->op = (BinaryOperator)record->op;
+    node->slot = record->slot;
+    node->frame_size = record->frame_size;
+    if (!load_string(loader, record->value, &node->value)) return NULL;
+
+    switch (node->type) {
+        case AST_NUMBER:
+            node->literal.int_val = (int)record->literal;
+            break;
+        case AST_FLOAT:
+            memcpy(&node->literal.float_val, &record->literal, sizeof(record->literal));
+            break;
+        case AST_BOOLEAN:
+            node->literal.bool_val = record->literal != 0;
+            break;
+        case AST_STRING: {
+            char* str;
+            if (!load_string(loader, record->literal, &str) || !str) return NULL;
+            node->literal.str_val = str;
+            break;
+        }
+        case AST_CALL:
+            // Pointer builtin tidak disimpan; cari lagi di registry proses ini
+            if (node->slot < 0) {
+                if (!node->value) return NULL;
+                node->literal.builtin = find_builtin(node->value);
+                if (!node->literal.builtin) return NULL;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Setiap node selain root adalah anak tepat satu node
+    uint32_t count = record->children_count;
+    if (count > loader->node_count - loader->next) return NULL;
+    if (!check_indices(loader, node, index, count)) return NULL;
+
+    if (node->type == AST_FUNCTION) loader->function = node;
+    if (count > 0) {
+        node->children = &loader->children[loader->children_used];
+        loader->children_used += count;
+        node->children_count = (int)count;
+        node->children_capacity = (int)count;
+        for (uint32_t i = 0; i < count; i++) {
+            node->children[i] = load_node(loader);
+            if (!node->children[i]) return NULL;
+        }
+    }
+    if (node->type == AST_FUNCTION) loader->function = NULL;
+
+    if (!check_children(node)) return NULL;
+    if (node->type == AST_CALL && node->slot < 0 && !check_callbacks(loader, node)) {
+        return NULL;
+    }
+    return node;
+}
+
+// Setelah semua fungsi dimuat: root hanya berisi fungsi bernama unik dengan
+// slot sama dengan index-nya, dan pemanggilan fungsi user sesuai jumlah
+// parameter
+static bool check_calls(const ASTNode* program, const ASTNode* node) {
+    if (node->type == AST_CALL && node->slot >= 0 &&
+        node->children_count != function_param_count(program->children[node->slot])) {
+        return false;
+    }
+    for (int i = 0; i < node->children_count; i++) {
+        if (!check_calls(program, node->children[i])) return false;
+    }
+    return true;
+}
+
+static bool check_program(const ASTNode* program) {
+    for (int i = 0; i < program->children_count; i++) {
+        const ASTNode* function = program->children[i];
+        if (function->type != AST_FUNCTION || function->slot != i || !function->value) {
+            return false;
+        }
+        for (int j = 0; j < i; j++) {
+            if (strcmp(program->children[j]->value, function->value) == 0) return false;
+        }
+    }
+    return check_calls(program, program);
+}
+
+ASTNode* cache_decode(const char* data, size_t size, uint64_t hash, size_t source_length) {
+    if (size < sizeof(CacheHeader)) return NULL;
+
+    CacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    size_t node_bytes = (size_t)header.node_count * sizeof(CacheNode);
+
+    if (memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.node_size != sizeof(CacheNode) ||
+        header.source_hash != hash ||
+        header.source_length != source_length ||
+        header.node_count == 0 ||
+        size != sizeof(header) + node_bytes + header.string_bytes ||
+        (header.string_bytes > 0 && data[size - 1] != '\0') ||
+        header.payload_hash != payload_hash(data + sizeof(header), node_bytes,
+                                            data + sizeof(header) + node_bytes,
+                                            header.string_bytes)) {
+        return NULL;
+    }
+
+    Arena* arena = create_arena();
+    if (!arena) return NULL;
+
+    // Tiga alokasi untuk seluruh AST: node, children dan pool string
+    Loader loader = {
+        .records = (const CacheNode*)(data + sizeof(header)),
+        .node_count = header.node_count,
+        .string_bytes = header.string_bytes,
+    };
+    loader.nodes = arena_alloc(arena, (size_t)header.node_count * sizeof(ASTNode));
+    loader.children = arena_alloc(arena, (size_t)header.node_count * sizeof(ASTNode*));
+    loader.strings = arena_alloc(arena, header.string_bytes + 1);
+    if (!loader.nodes || !loader.children || !loader.strings) {
+        free_arena(arena);
+        return NULL;
+    }
+
+    memset(loader.nodes, 0, (size_t)header.node_count * sizeof(ASTNode));
+    memcpy(loader.strings, data + sizeof(header) + node_bytes, header.string_bytes);
+
+    ASTNode* program = load_node(&loader);
+    if (!program || program->type != AST_PROGRAM || loader.next != header.node_count ||
+        !check_program(program)) {
+        free_arena(arena);
+        return NULL;
+    }
+    program->arena = arena;
+    return program;
+}
+
+ASTNode* cache_load(const char* cache_path, uint64_t hash, size_t source_length) {
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CacheHeader)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const char* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    ASTNode* program = cache_decode(data, size, hash, source_length);
+    munmap((void*)data, size);
+    return program;
+}
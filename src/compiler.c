@@ -0,0 +1,415 @@
+#include "compiler.h"
+#include "builtin.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    Chunk* chunk;
+    Function* function; // Fungsi yang sedang dikompilasi
+    int temp_top;       // Register sementara berikutnya
+    ASTNode* program;
+} Compiler;
+
+static void compile_statement(Compiler* compiler, ASTNode* node);
+static void compile_expression(Compiler* compiler, ASTNode* node, int dst);
+
+static void compiler_error(const char* message) {
+    fprintf(stderr, "Compiler Error: %s\n", message);
+    exit(1);
+}
+
+static int emit(Compiler* compiler, OpCode op, int a, int b, int c) {
+    Chunk* chunk = compiler->chunk;
+    if (chunk->count == chunk->capacity) {
+        chunk->capacity = chunk->capacity ? chunk->capacity * 2 : 64;
+        chunk->code = realloc(chunk->code, chunk->capacity * sizeof(Instruction));
+    }
+
+    Instruction* inst = &chunk->code[chunk->count];
+    inst->op = (uint8_t)op;
+    inst->n = 0;
+    inst->a = (uint16_t)a;
+    inst->b = (uint16_t)b;
+    inst->c = (uint16_t)c;
+    return chunk->count++;
+}
+
+static int emit_jump(Compiler* compiler, OpCode op, int a) {
+    return emit(compiler, op, a, 0, 0);
+}
+
+// Arahkan lompatan di index ke posisi instruksi berikutnya
+static void patch_jump(Compiler* compiler, int index) {
+    compiler->chunk->code[index].sbx = compiler->chunk->count - index - 1;
+}
+
+static int add_constant(Compiler* compiler, Value value) {
+    Chunk* chunk = compiler->chunk;
+    if (chunk->constant_count == chunk->constant_capacity) {
+        chunk->constant_capacity = chunk->constant_capacity ? chunk->constant_capacity * 2 : 16;
+        chunk->constants = realloc(chunk->constants, chunk->constant_capacity * sizeof(Value));
+    }
+    chunk->constants[chunk->constant_count] = value;
+    return chunk->constant_count++;
+}
+
+// Register 0..frame_size-1 adalah slot variabel hasil resolver
+static int variable_register(ASTNode* node) {
+    if (node->slot < 0) {
+        fprintf(stderr, "Error: Variable '%s' not found\n", node->value);
+        exit(1);
+    }
+    return node->slot;
+}
+
+// true kalau node membaca variabel yang disimpan di register reg
+static bool reads_register(const ASTNode* node, int reg) {
+    if ((node->type == AST_IDENTIFIER || node->type == AST_ARRAY_ACCESS) && node->slot == reg) {
+        return true;
+    }
+    for (int i = 0; i < node->children_count; i++) {
+        if (reads_register(node->children[i], reg)) return true;
+    }
+    return false;
+}
+
+static int alloc_temp(Compiler* compiler) {
+    int reg = compiler->temp_top++;
+    if (reg > RK_MAX) {
+        compiler_error("Too many registers");
+    }
+    if (compiler->temp_top > compiler->function->register_count) {
+        compiler->function->register_count = compiler->temp_top;
+    }
+    return reg;
+}
+
+static OpCode binary_opcode(BinaryOperator op) {
+    switch (op) {
+        case BINOP_ADD: return OP_ADD;
+        case BINOP_SUB: return OP_SUB;
+        case BINOP_MUL: return OP_MUL;
+        case BINOP_DIV: return OP_DIV;
+        case BINOP_LT: return OP_LT;
+        case BINOP_GT: return OP_GT;
+        default:
+            compiler_error("Unknown binary operator");
+            return OP_RETURN;
+    }
+}
+
+static void emit_loadk(Compiler* compiler, int dst, int index) {
+    int idx = emit(compiler, OP_LOADK, dst, 0, 0);
+    compiler->chunk->code[idx].sbx = index;
+}
+
+// Masukkan literal ke constant pool; -1 kalau node bukan literal
+static int literal_constant(Compiler* compiler, ASTNode* node) {
+    Value constant = {0};
+
+    switch (node->type) {
+        case AST_NUMBER:
+            constant.type = TYPE_INT;
+            constant.value.int_val = node->literal.int_val;
+            break;
+
+        case AST_FLOAT:
+            constant.type = TYPE_FLOAT;
+            constant.value.float_val = node->literal.float_val;
+            break;
+
+        case AST_STRING:
+            constant = make_string(node->literal.str_val, strlen(node->literal.str_val));
+            break;
+
+        default:
+            return -1;
+    }
+    return add_constant(compiler, constant);
+}
+
+// Hasilkan operand RK: literal masuk constant pool, variabel langsung
+// dipakai registernya, selain itu dihitung ke register sementara.
+// Constant di luar jangkauan RK dimuat dulu ke register sementara.
+static int compile_operand(Compiler* compiler, ASTNode* node) {
+    if (node->type == AST_IDENTIFIER) {
+        return variable_register(node);
+    }
+
+    int constant = literal_constant(compiler, node);
+    if (constant >= 0 && constant <= RK_MAX) {
+        return constant | RK_CONST;
+    }
+
+    int reg = alloc_temp(compiler);
+    if (constant >= 0) {
+        emit_loadk(compiler, reg, constant);
+    } else {
+        compile_expression(compiler, node, reg);
+    }
+    return reg;
+}
+
+// Seperti compile_operand tapi hasilnya selalu berupa register
+static int compile_register(Compiler* compiler, ASTNode* node) {
+    if (node->type == AST_IDENTIFIER) {
+        return variable_register(node);
+    }
+    int reg = alloc_temp(compiler);
+    compile_expression(compiler, node, reg);
+    return reg;
+}
+
+static void compile_expression(Compiler* compiler, ASTNode* node, int dst) {
+    int saved_top = compiler->temp_top;
+
+    switch (node->type) {
+        case AST_NUMBER: {
+            int idx = emit(compiler, OP_LOADI, dst, 0, 0);
+            compiler->chunk->code[idx].sbx = node->literal.int_val;
+            break;
+        }
+
+        case AST_FLOAT:
+        case AST_STRING:
+            emit_loadk(compiler, dst, literal_constant(compiler, node));
+            break;
+
+        case AST_BOOLEAN: {
+            Value constant = {0};
+            constant.type = TYPE_BOOLEAN;
+            constant.value.bool_val = node->literal.bool_val;
+            emit_loadk(compiler, dst, add_constant(compiler, constant));
+            break;
+        }
+
+        case AST_IDENTIFIER: {
+            int src = variable_register(node);
+            if (src != dst) {
+                emit(compiler, OP_MOVE, dst, src, 0);
+            }
+            break;
+        }
+
+        case AST_BINARY_OP: {
+            // (a + b) + c dihitung langsung di dst lalu ditambah di tempat,
+            // jadi rangkaian string tidak menyalin hasil antara
+            ASTNode* inner = node->children[0];
+            if (node->op == BINOP_ADD && inner->type == AST_BINARY_OP &&
+                !reads_register(node->children[1], dst)) {
+                compile_expression(compiler, inner, dst);
+                int right = compile_operand(compiler, node->children[1]);
+                emit(compiler, OP_ADD, dst, dst, right);
+                break;
+            }
+            int left = compile_operand(compiler, node->children[0]);
+            int right = compile_operand(compiler, node->children[1]);
+            emit(compiler, binary_opcode(node->op), dst, left, right);
+            break;
+        }
+
+        case AST_CALL: {
+            if (node->slot >= 0) {
+                // Argumen di register berurutan paling atas; frame fungsi
+                // yang dipanggil dimulai tepat di argumen pertama
+                int base = compiler->temp_top;
+                for (int i = 0; i < node->children_count; i++) {
+                    compile_expression(compiler, node->children[i], alloc_temp(compiler));
+                }
+                int idx = emit(compiler, OP_CALLFN, dst, node->slot, base);
+                compiler->chunk->code[idx].n = (uint8_t)node->children_count;
+                break;
+            }
+
+            // Array yang dipinjam tidak disalin: builtin menerima nomor
+            // register-nya. Array yang bukan variabel dihitung dulu ke
+            // register sementara, di bawah blok argumen supaya argumen
+            // tetap berurutan.
+            const Builtin* builtin = node->literal.builtin;
+            int borrowed[BUILTIN_MAX_ARGS] = {0};
+            for (int i = 0; i < node->children_count; i++) {
+                if (builtin->borrowed & (1u << i)) {
+                    borrowed[i] = compile_register(compiler, node->children[i]);
+                }
+            }
+
+            int base = compiler->temp_top;
+            for (int i = 0; i < node->children_count; i++) {
+                int reg = alloc_temp(compiler);
+                if (builtin->borrowed & (1u << i)) {
+                    int load = emit(compiler, OP_LOADI, reg, 0, 0);
+                    compiler->chunk->code[load].sbx = borrowed[i];
+                } else {
+                    compile_expression(compiler, node->children[i], reg);
+                }
+            }
+            int idx = emit(compiler, OP_CALL, dst, builtin->id, base);
+            compiler->chunk->code[idx].n = (uint8_t)node->children_count;
+            break;
+        }
+
+        case AST_ARRAY_DECL: {
+            int idx = emit(compiler, OP_NEWARRAY, dst, compile_operand(compiler, node->children[0]), 0);
+            compiler->chunk->code[idx].n = (uint8_t)node->data_type;
+            break;
+        }
+
+        case AST_ARRAY_ACCESS: {
+            int arr = variable_register(node);
+            emit(compiler, OP_GETINDEX, dst, arr, compile_operand(compiler, node->children[0]));
+            break;
+        }
+
+        default: {
+            Value constant = {0};
+            constant.type = TYPE_VOID;
+            emit_loadk(compiler, dst, add_constant(compiler, constant));
+            break;
+        }
+    }
+
+    compiler->temp_top = saved_top;
+}
+
+static void compile_block(Compiler* compiler, ASTNode* node) {
+    for (int i = 0; i < node->children_count; i++) {
+        compile_statement(compiler, node->children[i]);
+    }
+}
+
+static void compile_statement(Compiler* compiler, ASTNode* node) {
+    if (!node) return;
+    int saved_top = compiler->temp_top;
+
+    switch (node->type) {
+        case AST_BLOCK:
+            compile_block(compiler, node);
+            break;
+
+        case AST_RETURN:
+            if (node->children_count > 0 && node->children[0]->type == AST_CALL &&
+                node->children[0]->slot >= 0) {
+                // Tail call: argumen di register teratas, lalu digeser ke
+                // R[0..] oleh OP_TAILCALL
+                ASTNode* call = node->children[0];
+                int base = compiler->temp_top;
+                for (int i = 0; i < call->children_count; i++) {
+                    compile_expression(compiler, call->children[i], alloc_temp(compiler));
+                }
+                int idx = emit(compiler, OP_TAILCALL, 0, call->slot, base);
+                compiler->chunk->code[idx].n = (uint8_t)call->children_count;
+            } else if (node->children_count > 0) {
+                int value = compile_operand(compiler, node->children[0]);
+                int idx = emit(compiler, OP_RETURN, 0, value, 0);
+                compiler->chunk->code[idx].n = 1;
+            }
+            break;
+
+        case AST_CALL:
+            if (node->slot < 0 && node->literal.builtin->id == BUILTIN_CETAK) {
+                emit(compiler, OP_PRINT, 0, compile_operand(compiler, node->children[0]), 0);
+            } else {
+                // Pemanggilan sebagai statement; hasilnya dibuang
+                compile_expression(compiler, node, alloc_temp(compiler));
+            }
+            break;
+
+        case AST_VARIABLE_DECL:
+        case AST_ASSIGNMENT:
+            if (node->children_count > 0) {
+                compile_expression(compiler, node->children[0],
+                                   variable_register(node));
+            }
+            break;
+
+        case AST_IF:
+            if (node->children_count >= 2) {
+                int cond = compile_register(compiler, node->children[0]);
+                int jump = emit_jump(compiler, OP_JMPF, cond);
+                compiler->temp_top = saved_top;
+                compile_statement(compiler, node->children[1]);
+                patch_jump(compiler, jump);
+            }
+            break;
+
+        case AST_WHILE: {
+            if (node->children_count < 2) break;
+
+            int loop_start = compiler->chunk->count;
+            int cond = compile_register(compiler, node->children[0]);
+            int exit_jump = emit_jump(compiler, OP_JMPF, cond);
+            compiler->chunk->code[exit_jump].n = 1;
+            compiler->temp_top = saved_top;
+
+            compile_block(compiler, node->children[1]);
+
+            int back = emit_jump(compiler, OP_JMP, 0);
+            compiler->chunk->code[back].sbx = loop_start - back - 1;
+            patch_jump(compiler, exit_jump);
+            break;
+        }
+
+        case AST_ARRAY_ASSIGN:
+            if (node->children_count == 2) {
+                int arr = variable_register(node);
+                int index = compile_operand(compiler, node->children[0]);
+                int value = compile_operand(compiler, node->children[1]);
+                emit(compiler, OP_SETINDEX, arr, index, value);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    compiler->temp_top = saved_top;
+}
+
+Chunk* compile_program(ASTNode* program) {
+    if (!program) return NULL;
+
+    Chunk* chunk = calloc(1, sizeof(Chunk));
+    if (!chunk) return NULL;
+
+    Compiler compiler = {0};
+    compiler.chunk = chunk;
+    compiler.program = program;
+
+    // Satu fungsi AST menjadi satu Function dengan index yang sama; tiap
+    // body diakhiri OP_RETURN void untuk fungsi yang tidak memanggil kembali
+    chunk->function_count = program->children_count;
+    chunk->functions = calloc(chunk->function_count ? chunk->function_count : 1, sizeof(Function));
+    chunk->main_function = -1;
+    for (int i = 0; i < program->children_count; i++) {
+        ASTNode* node = program->children[i];
+        if (node->frame_size > RK_MAX) {
+            compiler_error("Too many variables");
+        }
+
+        Function* function = &chunk->functions[i];
+        function->name = node->value;
+        function->entry = chunk->count;
+        function->param_count = function_param_count(node);
+        function->register_count = node->frame_size;
+        if (strcmp(node->value, "main") == 0) chunk->main_function = i;
+
+        compiler.function = function;
+        compiler.temp_top = node->frame_size;
+        compile_statement(&compiler, node->children[node->children_count - 1]);
+        emit(&compiler, OP_RETURN, 0, 0, 0);
+    }
+    return chunk;
+}
+
+void free_chunk(Chunk* chunk) {
+    if (!chunk) return;
+
+    for (int i = 0; i < chunk->constant_count; i++) {
+        release_value(&chunk->constants[i]);
+    }
+    free(chunk->constants);
+    free(chunk->functions);
+    free(chunk->code);
+    free(chunk);
+}
@@ -0,0 +1,305 @@
+#include "http.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Batas kapasitas awal dari Content-Length; server bisa mengaku apa saja,
+// jadi body yang lebih besar dicapai lewat penggandaan biasa
+#define RESPONSE_PRESIZE_MAX (8 * 1024 * 1024)
+
+// Buffer response. Kapasitas diambil dari Content-Length kalau server
+// mengirimnya, dan tumbuh dua kali lipat kalau ternyata kurang.
+struct ResponseData {
+    CURL* curl;
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+static bool response_reserve(struct ResponseData* resp, size_t needed) {
+    if (needed <= resp->capacity) return true;
+
+    size_t capacity = resp->capacity ? resp->capacity * 2 : 4096;
+    if (resp->capacity == 0 && resp->curl) {
+        curl_off_t length = -1;
+        curl_easy_getinfo(resp->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        if (length > 0) {
+            capacity = length < RESPONSE_PRESIZE_MAX ? (size_t)length + 1 : RESPONSE_PRESIZE_MAX;
+        }
+    }
+    while (capacity < needed) capacity *= 2;
+
+    char* ptr = realloc(resp->data, capacity);
+    if (!ptr) return false;
+    resp->data = ptr;
+    resp->capacity = capacity;
+    return true;
+}
+
+// Buffer body diambil alih String tanpa disalin; resp kosong lagi sesudahnya
+static String* response_take(struct ResponseData* resp) {
+    if (!resp->data && !response_reserve(resp, 1)) return NULL;
+    resp->data[resp->size] = '\0';
+
+    String* body = string_adopt(resp->data, resp->size);
+    resp->data = NULL;
+    resp->size = resp->capacity = 0;
+    return body;
+}
+
+// Callback untuk CURL
+static size_t write_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t realsize = size * nmemb;
+    struct ResponseData* resp = (struct ResponseData*)userp;
+    
+    if (!response_reserve(resp, resp->size + realsize + 1)) return 0;
+    
+    memcpy(&(resp->data[resp->size]), contents, realsize);
+    resp->size += realsize;
+    resp->data[resp->size] = 0;
+    
+    return realsize;
+}
+
+HttpClient* create_http_client(void) {
+    static bool curl_ready = false;
+    if (!curl_ready) {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        curl_ready = true;
+    }
+
+    HttpClient* client = malloc(sizeof(HttpClient));
+    if (!client) return NULL;
+    client->handle_count = 0;
+    client->multi = NULL;
+
+    // Satu thread, jadi share tidak perlu callback lock
+    client->share = curl_share_init();
+    if (client->share) {
+        curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+    return client;
+}
+
+void free_http_client(HttpClient* client) {
+    if (!client) return;
+    for (int i = 0; i < client->handle_count; i++) {
+        curl_easy_cleanup(client->handles[i]);
+    }
+    if (client->multi) curl_multi_cleanup(client->multi);
+    if (client->share) curl_share_cleanup(client->share);
+    free(client);
+}
+
+CURL* http_acquire(HttpClient* client) {
+    CURL* curl = client->handle_count > 0
+        ? client->handles[--client->handle_count]
+        : curl_easy_init();
+    if (!curl) return NULL;
+
+    // Opsi dipasang ulang tiap kali karena http_release me-reset handle
+    if (client->share) curl_easy_setopt(curl, CURLOPT_SHARE, client->share);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    return curl;
+}
+
+void http_release(HttpClient* client, CURL* curl) {
+    if (!curl) return;
+    if (client->handle_count < HTTP_POOL_SIZE) {
+        // Reset opsi saja; koneksi dan cache tetap hidup
+        curl_easy_reset(curl);
+        client->handles[client->handle_count++] = curl;
+    } else {
+        curl_easy_cleanup(curl);
+    }
+}
+
+static Value perform_request(HttpClient* client, const char* url, const char* post_data) {
+    Value result = {0};
+    CURL* curl = http_acquire(client);
+    if(curl) {
+        struct ResponseData resp = {0};
+        resp.curl = curl;
+        
+        curl_easy_setopt(curl, CURLOPT_URL, url);
+        if (post_data) curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_data);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&resp);
+        
+        CURLcode res = curl_easy_perform(curl);
+        if(res == CURLE_OK) {
+            result = string_value(response_take(&resp));
+        }
+        
+        free(resp.data);
+        http_release(client, curl);
+    }
+    return result;
+}
+
+// Implementasi HTTP GET
+Value http_get(HttpClient* client, const char* url) {
+    return perform_request(client, url, NULL);
+}
+
+// Implementasi HTTP POST
+Value http_post(HttpClient* client, const char* url, const char* data) {
+    return perform_request(client, url, data);
+}
+
+// Ambil semua URL sekaligus lewat curl_multi dalam satu event loop.
+// Paling banyak max_concurrent transfer berjalan bersamaan; transfer
+// berikutnya dimulai begitu ada yang selesai.
+Value http_get_all(HttpClient* client, const Value* urls, int max_concurrent) {
+    Value result = {0};
+    if (!urls || urls->type != TYPE_ARRAY_STRING) return result;
+
+    int count = urls->array_size;
+    result = make_array(TYPE_ARRAY_STRING, count);
+    if (count == 0) return result;
+
+    if (!client->multi) client->multi = curl_multi_init();
+    if (!client->multi) return result;
+    if (max_concurrent <= 0) max_concurrent = HTTP_MAX_CONCURRENT;
+
+    struct ResponseData* responses = calloc(count, sizeof(struct ResponseData));
+    if (!responses) return result;
+    int next = 0;
+    int active = 0;
+
+    while (next < count || active > 0) {
+        // Isi slot kosong sampai batas concurrency
+        while (next < count && active < max_concurrent) {
+            const char* url = urls->value.str_array[next] ? urls->value.str_array[next]->data : NULL;
+            CURL* curl = url ? http_acquire(client) : NULL;
+            if (curl) {
+                responses[next].curl = curl;
+                curl_easy_setopt(curl, CURLOPT_URL, url);
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&responses[next]);
+                curl_easy_setopt(curl, CURLOPT_PRIVATE, (void*)(intptr_t)next);
+                curl_multi_add_handle(client->multi, curl);
+                active++;
+            }
+            next++;
+        }
+
+        int running = 0;
+        curl_multi_perform(client->multi, &running);
+
+        CURLMsg* msg;
+        int queued;
+        while ((msg = curl_multi_info_read(client->multi, &queued))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            CURL* curl = msg->easy_handle;
+            void* private_data = NULL;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, &private_data);
+            int index = (int)(intptr_t)private_data;
+
+            // Body yang gagal dibiarkan NULL (dicetak sebagai string kosong)
+            if (msg->data.result == CURLE_OK) {
+                result.value.str_array[index] = response_take(&responses[index]);
+            } else {
+                free(responses[index].data);
+                responses[index].data = NULL;
+            }
+
+            curl_multi_remove_handle(client->multi, curl);
+            http_release(client, curl);
+            active--;
+        }
+
+        // Tunggu aktivitas socket hanya kalau tidak ada slot yang bisa diisi;
+        // info_read dibaca dulu supaya transfer yang sudah selesai tidak
+        // menunggu timeout poll
+        bool can_start = next < count && active < max_concurrent;
+        if (active > 0 && !can_start) {
+            curl_multi_poll(client->multi, NULL, 0, 1000, NULL);
+        }
+    }
+
+    free(responses);
+    return result;
+}
+
+// Potongan baris yang belum lengkap disimpan sampai newline berikutnya
+// datang, jadi memori terpakai sebatas baris terpanjang, bukan seluruh body.
+struct LineStream {
+    HttpLineCallback callback;
+    void* context;
+    char* pending;
+    size_t size;
+    size_t capacity;
+};
+
+static bool pending_append(struct LineStream* stream, const char* data, size_t length) {
+    if (stream->size + length > stream->capacity) {
+        size_t capacity = stream->capacity ? stream->capacity * 2 : 256;
+        while (capacity < stream->size + length) capacity *= 2;
+        char* ptr = realloc(stream->pending, capacity);
+        if (!ptr) return false;
+        stream->pending = ptr;
+        stream->capacity = capacity;
+    }
+    memcpy(stream->pending + stream->size, data, length);
+    stream->size += length;
+    return true;
+}
+
+static void emit_line(struct LineStream* stream, const char* line, size_t length) {
+    if (length > 0 && line[length - 1] == '\r') length--;
+    stream->callback(line, length, stream->context);
+}
+
+static size_t line_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t realsize = size * nmemb;
+    struct LineStream* stream = (struct LineStream*)userp;
+    const char* data = contents;
+    const char* end = data + realsize;
+
+    const char* newline;
+    while ((newline = memchr(data, '\n', end - data))) {
+        if (stream->size > 0) {
+            // Sambungkan dengan sisa chunk sebelumnya
+            if (!pending_append(stream, data, newline - data)) return 0;
+            emit_line(stream, stream->pending, stream->size);
+            stream->size = 0;
+        } else {
+            // Baris utuh langsung dari buffer libcurl, tanpa salinan
+            emit_line(stream, data, newline - data);
+        }
+        data = newline + 1;
+    }
+
+    if (data < end && !pending_append(stream, data, end - data)) return 0;
+    return realsize;
+}
+
+bool http_stream_lines(HttpClient* client, const char* url,
+                       HttpLineCallback callback, void* context) {
+    CURL* curl = http_acquire(client);
+    if (!curl) return false;
+
+    struct LineStream stream = {0};
+    stream.callback = callback;
+    stream.context = context;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, line_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&stream);
+
+    CURLcode res = curl_easy_perform(curl);
+    // Baris terakhir tanpa newline tetap dikirim
+    if (res == CURLE_OK && stream.size > 0) {
+        emit_line(&stream, stream.pending, stream.size);
+    }
+
+    free(stream.pending);
+    http_release(client, curl);
+    return res == CURLE_OK;
+}
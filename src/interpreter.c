@@ -2,158 +2,114 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <curl/curl.h>
+#include <stdint.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
 
 // Forward declarations
 static Value evaluate_expression(Interpreter* interpreter, ASTNode* node);
 static void interpret_block(Interpreter* interpreter, ASTNode* node);
-static void interpret_function(Interpreter* interpreter, ASTNode* node);
 
-// Tambahkan di bagian atas file setelah includes
-#define MAX_ARRAY_SIZE 1000
-
-// Struktur untuk menyimpan response
-struct ResponseData {
-    char* data;
-    size_t size;
-};
-
-// Callback untuk CURL
-static size_t write_callback(void* contents, size_t size, size_t nmemb, void* userp) {
-    size_t realsize = size * nmemb;
-    struct ResponseData* resp = (struct ResponseData*)userp;
-    
-    char* ptr = realloc(resp->data, resp->size + realsize + 1);
-    if(!ptr) return 0;
-    
-    resp->data = ptr;
-    memcpy(&(resp->data[resp->size]), contents, realsize);
-    resp->size += realsize;
-    resp->data[resp->size] = 0;
-    
-    return realsize;
-}
-
-// Implementasi HTTP GET
-Value evaluate_http_get(const char* url) {
-    Value result = {0};
-    CURL* curl = curl_easy_init();
-    if(curl) {
-        struct ResponseData resp = {0};
-        resp.data = malloc(1);
-        resp.size = 0;
-        
-        curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&resp);
-        
-        CURLcode res = curl_easy_perform(curl);
-        if(res == CURLE_OK) {
-            result.type = TYPE_STRING;
-            result.value.str_val = strdup(resp.data);
-        }
-        
-        free(resp.data);
-        curl_easy_cleanup(curl);
-    }
-    return result;
+Interpreter* create_interpreter(void) {
+    Interpreter* interpreter = create_interpreter_shared(create_http_client(), STDOUT_FILENO);
+    if (interpreter) interpreter->owns_http = true;
+    return interpreter;
 }
 
-// Implementasi HTTP POST
-Value evaluate_http_post(const char* url, const char* data) {
-    Value result = {0};
-    CURL* curl = curl_easy_init();
-    if(curl) {
-        struct ResponseData resp = {0};
-        resp.data = malloc(1);
-        resp.size = 0;
-        
-        curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&resp);
-        
-        CURLcode res = curl_easy_perform(curl);
-        if(res == CURLE_OK) {
-            result.type = TYPE_STRING;
-            result.value.str_val = strdup(resp.data);
-        }
-        
-        free(resp.data);
-        curl_easy_cleanup(curl);
-    }
-    return result;
-}
+static Value call_from_builtin(BuiltinContext* context, int index, Value* args, int argc);
 
-Interpreter* create_interpreter(void) {
+Interpreter* create_interpreter_shared(HttpClient* http, int out_fd) {
     Interpreter* interpreter = (Interpreter*)malloc(sizeof(Interpreter));
     if (!interpreter) return NULL;
-    interpreter->variable_count = 0;
+    interpreter->stack = NULL;
+    interpreter->stack_capacity = 0;
+    interpreter->frame = NULL;
+    interpreter->stack_top = 0;
+    interpreter->stack_used = 0;
+    interpreter->depth = 0;
+    interpreter->max_depth = MAX_CALL_DEPTH;
+    interpreter->returning = false;
+    interpreter->aborted = false;
+    interpreter->interrupt = NULL;
+    interpreter->return_value.type = TYPE_VOID;
+    interpreter->tail_function = NULL;
+    interpreter->tail_argc = 0;
+    interpreter->c_stack_base = NULL;
+    // Separuh batas stack C; sisanya untuk builtin (libcurl) dan pemanggil
+    struct rlimit limit;
+    interpreter->c_stack_budget = 4 * 1024 * 1024;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        interpreter->c_stack_budget = limit.rlim_cur / 2;
+    }
+    interpreter->http = http;
+    interpreter->owns_http = false;
+    interpreter->program = NULL;
+    interpreter->out = create_output(out_fd);
+    interpreter->builtins = (BuiltinContext){ http, interpreter->out, interpreter, call_from_builtin };
     return interpreter;
 }
 
 void free_interpreter(Interpreter* interpreter) {
     if (interpreter) {
-        for (int i = 0; i < interpreter->variable_count; i++) {
-            free(interpreter->variables[i].name);
+        for (int i = 0; i < interpreter->stack_used; i++) {
+            if (interpreter->stack[i].defined) {
+                release_value(&interpreter->stack[i].value);
+            }
         }
+        free(interpreter->stack);
+        if (interpreter->owns_http) free_http_client(interpreter->http);
+        free_output(interpreter->out);
         free(interpreter);
     }
 }
 
-// Modifikasi get_variable untuk mengembalikan Value*
-static Value* get_variable(Interpreter* interpreter, const char* name) {
-    for (int i = 0; i < interpreter->variable_count; i++) {
-        if (strcmp(interpreter->variables[i].name, name) == 0) {
-            return interpreter->variables[i].value;
-        }
+// Slot sudah di-resolve saat parsing, jadi akses variabel cukup satu index
+// di frame fungsi yang sedang berjalan
+static Value* get_variable(Interpreter* interpreter, ASTNode* node) {
+    if (node->slot >= 0 && interpreter->frame[node->slot].defined) {
+        return &interpreter->frame[node->slot].value;
     }
-    fprintf(stderr, "Error: Variable '%s' not found\n", name);
+    fprintf(stderr, "Error: Variable '%s' not found\n", node->value);
     return NULL;
 }
 
-// Modifikasi set_variable untuk menerima Value*
-static void set_variable(Interpreter* interpreter, const char* name, Value* value) {
-    for (int i = 0; i < interpreter->variable_count; i++) {
-        if (strcmp(interpreter->variables[i].name, name) == 0) {
-            free_value(interpreter->variables[i].value);
-            interpreter->variables[i].value = value;
-            return;
-        }
-    }
-    
-    if (interpreter->variable_count < MAX_VARIABLES) {
-        interpreter->variables[interpreter->variable_count].name = strdup(name);
-        interpreter->variables[interpreter->variable_count].value = value;
-        interpreter->variable_count++;
-    } else {
-        fprintf(stderr, "Error: Too many variables\n");
+// Slot mengambil alih kepemilikan value. Kalau tipenya sama dan skalar,
+// nilai lama cukup ditimpa di tempat tanpa alokasi apa pun.
+static void set_variable(Interpreter* interpreter, ASTNode* node, Value value) {
+    if (node->slot < 0) {
+        fprintf(stderr, "Error: Variable '%s' not resolved\n", node->value);
         exit(1);
     }
-}
+    Variable* var = &interpreter->frame[node->slot];
+    if (var->defined && var->value.type == value.type &&
+        (value.type == TYPE_INT || value.type == TYPE_FLOAT || value.type == TYPE_BOOLEAN)) {
+        var->value.value = value.value;
+        return;
+    }
 
-// Fungsi helper untuk array
-static Value* create_array_value(int size) {
-    Value* val = malloc(sizeof(Value));
-    if (!val) return NULL;
-    
-    val->type = TYPE_ARRAY_INT;
-    val->array_size = size;
-    val->value.int_array = calloc(size, sizeof(int));
-    
-    return val;
+    if (var->defined) release_value(&var->value);
+    var->name = node->value;
+    var->value = value;
+    var->defined = true;
 }
 
 static void interpret_array_assign(Interpreter* interpreter, ASTNode* node) {
     if (!node || node->children_count != 2) return;
     
-    Value* arr = get_variable(interpreter, node->value);
-    if (!arr || arr->type != TYPE_ARRAY_INT) {
+    Value* arr = get_variable(interpreter, node);
+    if (!arr || !is_array_type(arr->type)) {
         fprintf(stderr, "Error: Invalid array access\n");
         return;
     }
     
     Value index_val = evaluate_expression(interpreter, node->children[0]);
+    if (index_val.type != TYPE_INT) {
+        fprintf(stderr, "Error: Array index must be an integer\n");
+        release_value(&index_val);
+        return;
+    }
     int index = index_val.value.int_val;
     
     if (index < 0 || index >= arr->array_size) {
@@ -162,41 +118,223 @@ static void interpret_array_assign(Interpreter* interpreter, ASTNode* node) {
     }
     
     Value new_val = evaluate_expression(interpreter, node->children[1]);
-    arr->value.int_array[index] = new_val.value.int_val;
+    if (!array_set(arr, index, &new_val)) {
+        fprintf(stderr, "Error: Array element type mismatch\n");
+    }
+    release_value(&new_val);
 }
 
-// Tambahkan fungsi untuk process escape sequences
-static char* process_string(const char* input) {
-    if (!input) return NULL;
-    
-    int len = strlen(input);
-    char* output = malloc(len + 1);
-    int j = 0;
-    
-    for (int i = 0; i < len; i++) {
-        if (input[i] == '\\' && i + 1 < len) {
-            switch (input[i + 1]) {
-                case 'n':
-                    output[j++] = '\n';
-                    i++;
-                    break;
-                case 't':
-                    output[j++] = '\t';
-                    i++;
-                    break;
-                case '\\':
-                    output[j++] = '\\';
-                    i++;
-                    break;
-                default:
-                    output[j++] = input[i];
-            }
+// Error fatal: semua frame dibongkar tanpa menjalankan apa pun lagi
+static void abort_call(Interpreter* interpreter) {
+    interpreter->aborted = true;
+    interpreter->returning = true;
+}
+
+// true kalau program diminta berhenti dari luar; semua frame dibongkar
+static bool interrupted(Interpreter* interpreter) {
+    if (!interpreter->interrupt || !*interpreter->interrupt) return false;
+    if (!interpreter->aborted) fprintf(stderr, "Error: Time limit exceeded\n");
+    abort_call(interpreter);
+    return true;
+}
+
+static void stack_exhausted(Interpreter* interpreter, ASTNode* function) {
+    fprintf(stderr, "Error: Call stack exhausted in '%s'\n", function->value);
+    abort_call(interpreter);
+}
+
+// Pemanggilan non-tail juga merekursi di C; sebelum stack C habis,
+// hentikan dengan error yang sama seperti stack slot penuh
+static bool c_stack_exhausted(Interpreter* interpreter) {
+    char here;
+    if (!interpreter->c_stack_base) return false;
+    return (uintptr_t)interpreter->c_stack_base - (uintptr_t)&here > interpreter->c_stack_budget;
+}
+
+// Sisihkan frame fungsi di puncak stack. Slot-nya kosong; pemanggil
+// mengisi argumen ke slot 0.. sebelum run_frame. NULL kalau stack penuh.
+static Variable* push_frame(Interpreter* interpreter, ASTNode* function) {
+    if (interpreter->aborted || interrupted(interpreter)) return NULL;
+    if (interpreter->depth >= interpreter->max_depth) {
+        fprintf(stderr, "Error: Maximum call depth %d exceeded in '%s'\n",
+                interpreter->max_depth, function->value);
+        abort_call(interpreter);
+        return NULL;
+    }
+    if (interpreter->stack_top + function->frame_size > interpreter->stack_capacity ||
+        c_stack_exhausted(interpreter)) {
+        stack_exhausted(interpreter, function);
+        return NULL;
+    }
+
+    Variable* frame = &interpreter->stack[interpreter->stack_top];
+    interpreter->stack_top += function->frame_size;
+    if (interpreter->stack_top > interpreter->stack_used) {
+        interpreter->stack_used = interpreter->stack_top;
+    }
+    interpreter->depth++;
+    return frame;
+}
+
+// Ganti isi frame dengan argumen tail call yang menunggu tepat di atasnya
+static bool reuse_frame(Interpreter* interpreter, ASTNode* function, Variable* frame) {
+    Variable* args = &interpreter->stack[interpreter->stack_top];
+    for (Variable* var = frame; var < args; var++) {
+        if (var->defined) {
+            release_value(&var->value);
+            var->defined = false;
+        }
+    }
+    // Argumen hanya bergeser turun, jadi urutan naik aman
+    for (int i = 0; i < interpreter->tail_argc; i++) {
+        if (&frame[i] == &args[i]) break;
+        frame[i] = args[i];
+        args[i].defined = false;
+    }
+    for (int i = 0; i < interpreter->tail_argc; i++) {
+        frame[i].name = function->children[i]->value;
+    }
+
+    int top = (int)(frame - interpreter->stack) + function->frame_size;
+    interpreter->stack_top = (int)(frame - interpreter->stack) + interpreter->tail_argc;
+    if (top > interpreter->stack_capacity) {
+        stack_exhausted(interpreter, function);
+        return false;
+    }
+    interpreter->stack_top = top;
+    if (top > interpreter->stack_used) interpreter->stack_used = top;
+    return true;
+}
+
+// Jalankan body fungsi di frame. Hasilnya nilai kembali, atau TYPE_VOID
+// kalau body selesai tanpa kembali. Tail call menjalankan fungsi berikutnya
+// di frame yang sama, tanpa rekursi C.
+static Value run_frame(Interpreter* interpreter, ASTNode* function, Variable* frame) {
+    Variable* caller = interpreter->frame;
+    interpreter->frame = frame;
+    interpret(interpreter, function->children[function->children_count - 1]);
+    while (interpreter->tail_function) {
+        function = interpreter->tail_function;
+        interpreter->tail_function = NULL;
+        if (interrupted(interpreter) || !reuse_frame(interpreter, function, frame)) break;
+        interpreter->returning = false;
+        interpret(interpreter, function->children[function->children_count - 1]);
+    }
+    interpreter->frame = caller;
+
+    Value result = interpreter->return_value;
+    interpreter->return_value.type = TYPE_VOID;
+    if (!interpreter->returning) result.type = TYPE_VOID;
+    // Error fatal terus membongkar frame pemanggil
+    interpreter->returning = interpreter->aborted;
+    return result;
+}
+
+static void pop_frame(Interpreter* interpreter, Variable* frame) {
+    for (Variable* var = frame; var < &interpreter->stack[interpreter->stack_top]; var++) {
+        if (var->defined) {
+            release_value(&var->value);
+            var->defined = false;
+        }
+    }
+    interpreter->stack_top = (int)(frame - interpreter->stack);
+    interpreter->depth--;
+}
+
+// Argumen dihitung dulu ke slot parameter di puncak stack, di frame
+// pemanggil, lalu frame baru disisihkan di atasnya seperti VM. Pemanggilan
+// bersarang di argumen memakai stack di atas argumen dan belum menambah
+// kedalaman fungsi ini.
+static Value call_function(Interpreter* interpreter, ASTNode* node) {
+    ASTNode* function = interpreter->program->children[node->slot];
+    int argc = node->children_count;
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (interpreter->stack_top + argc > interpreter->stack_capacity) {
+        stack_exhausted(interpreter, function);
+        return result;
+    }
+
+    Variable* args = &interpreter->stack[interpreter->stack_top];
+    interpreter->stack_top += argc;
+    if (interpreter->stack_top > interpreter->stack_used) {
+        interpreter->stack_used = interpreter->stack_top;
+    }
+    for (int i = 0; i < argc; i++) {
+        args[i].value = evaluate_expression(interpreter, node->children[i]);
+        args[i].name = function->children[i]->value;
+        args[i].defined = true;
+    }
+    interpreter->stack_top -= argc;
+
+    Variable* frame = push_frame(interpreter, function);
+    if (!frame) {
+        for (int i = 0; i < argc; i++) {
+            release_value(&args[i].value);
+            args[i].defined = false;
+        }
+        return result;
+    }
+    result = run_frame(interpreter, function, frame);
+    pop_frame(interpreter, frame);
+    return result;
+}
+
+// BuiltinContext.call: fungsi callback dijalankan di frame-nya sendiri
+static Value call_from_builtin(BuiltinContext* context, int index, Value* args, int argc) {
+    Interpreter* interpreter = context->engine;
+    ASTNode* function = interpreter->program->children[index];
+    int count = function_param_count(function);
+    Variable* frame = push_frame(interpreter, function);
+
+    for (int i = 0; i < argc; i++) {
+        if (frame && i < count) {
+            frame[i].value = args[i];
+            frame[i].name = function->children[i]->value;
+            frame[i].defined = true;
         } else {
-            output[j++] = input[i];
+            release_value(&args[i]);
         }
     }
-    output[j] = '\0';
-    return output;
+    if (!frame) {
+        Value result = {0};
+        result.type = TYPE_VOID;
+        return result;
+    }
+    Value result = run_frame(interpreter, function, frame);
+    pop_frame(interpreter, frame);
+    return result;
+}
+
+// Argumen dihitung ke args, lalu builtin dipanggil lewat entry di node.
+// Array yang dipinjam diambil langsung dari variabelnya tanpa disalin.
+static Value call_builtin(Interpreter* interpreter, ASTNode* node) {
+    const Builtin* builtin = node->literal.builtin;
+    Value args[BUILTIN_MAX_ARGS];
+    unsigned borrowed = 0;
+    int argc = node->children_count;
+
+    for (int i = 0; i < argc; i++) {
+        ASTNode* arg = node->children[i];
+        if ((builtin->borrowed & (1u << i)) && arg->type == AST_IDENTIFIER) {
+            Value* var = get_variable(interpreter, arg);
+            args[i].type = TYPE_VOID;
+            if (var) args[i] = *var;
+            borrowed |= 1u << i;
+        } else {
+            args[i] = evaluate_expression(interpreter, arg);
+        }
+    }
+
+    Value result = {0};
+    // Error fatal di argumen: builtin tidak dijalankan, sama seperti VM
+    if (!interpreter->aborted) {
+        result = builtin->fn(&interpreter->builtins, args, argc);
+    }
+    for (int i = 0; i < argc; i++) {
+        if (!(borrowed & (1u << i))) release_value(&args[i]);
+    }
+    return result;
 }
 
 // Update fungsi evaluate_expression untuk string literals
@@ -207,187 +345,84 @@ static Value evaluate_expression(Interpreter* interpreter, ASTNode* node) {
     switch (node->type) {
         case AST_NUMBER:
             result.type = TYPE_INT;
-            result.value.int_val = atoi(node->value);
+            result.value.int_val = node->literal.int_val;
             break;
             
         case AST_FLOAT:
             result.type = TYPE_FLOAT;
-            result.value.float_val = atof(node->value);
+            result.value.float_val = node->literal.float_val;
             break;
             
-        case AST_STRING: {
-            result.type = TYPE_STRING;
-            result.value.str_val = process_string(node->value);
+        case AST_STRING:
+            result = make_string(node->literal.str_val, strlen(node->literal.str_val));
             break;
-        }
             
         case AST_BOOLEAN:
             result.type = TYPE_BOOLEAN;
-            result.value.bool_val = strcmp(node->value, "benar") == 0;
+            result.value.bool_val = node->literal.bool_val;
             break;
             
         case AST_IDENTIFIER: {
-            Value* var = get_variable(interpreter, node->value);
+            Value* var = get_variable(interpreter, node);
             if (var) {
-                result = *var;  // Copy the value
+                // Salinan milik pemanggil; slot tetap memegang aslinya
+                result = copy_value(var);
             }
             break;
         }
             
-        case AST_CALL: {
-            if (strcmp(node->value, "http_get") == 0) {
-                Value url_val = evaluate_expression(interpreter, node->children[0]);
-                if (url_val.type == TYPE_STRING) {
-                    result = evaluate_http_get(url_val.value.str_val);
-                    free(url_val.value.str_val);
-                }
-            }
-            else if (strcmp(node->value, "http_post") == 0) {
-                Value url_val = evaluate_expression(interpreter, node->children[0]);
-                Value data_val = evaluate_expression(interpreter, node->children[1]);
-                if (url_val.type == TYPE_STRING && data_val.type == TYPE_STRING) {
-                    result = evaluate_http_post(url_val.value.str_val, data_val.value.str_val);
-                    free(url_val.value.str_val);
-                    free(data_val.value.str_val);
-                }
-            }
-            else if (strcmp(node->value, "tambah") == 0) {
-                if (node->children_count == 2) {
-                    Value left = evaluate_expression(interpreter, node->children[0]);
-                    Value right = evaluate_expression(interpreter, node->children[1]);
-                    
-                    if (left.type == TYPE_INT && right.type == TYPE_INT) {
-                        result.type = TYPE_INT;
-                        result.value.int_val = left.value.int_val + right.value.int_val;
-                    }
-                }
-            }
-            else if (strcmp(node->value, "bagi") == 0) {
-                if (node->children_count == 2) {
-                    Value left = evaluate_expression(interpreter, node->children[0]);
-                    Value right = evaluate_expression(interpreter, node->children[1]);
-                    
-                    if (left.type == TYPE_FLOAT && right.type == TYPE_FLOAT) {
-                        result.type = TYPE_FLOAT;
-                        result.value.float_val = left.value.float_val / right.value.float_val;
-                    }
-                }
-            }
-            else if (strcmp(node->value, "lebih_besar") == 0) {
-                if (node->children_count == 2) {
-                    Value left = evaluate_expression(interpreter, node->children[0]);
-                    Value right = evaluate_expression(interpreter, node->children[1]);
-                    
-                    if (left.type == TYPE_INT && right.type == TYPE_INT) {
-                        result.type = TYPE_BOOLEAN;
-                        result.value.bool_val = left.value.int_val > right.value.int_val;
-                    }
-                }
-            }
-            else if (strcmp(node->value, "gabung") == 0) {
-                if (node->children_count == 2) {
-                    Value left = evaluate_expression(interpreter, node->children[0]);
-                    Value right = evaluate_expression(interpreter, node->children[1]);
-                    
-                    if (left.type == TYPE_STRING && right.type == TYPE_STRING) {
-                        char* str_result = malloc(strlen(left.value.str_val) + strlen(right.value.str_val) + 1);
-                        strcpy(str_result, left.value.str_val);
-                        strcat(str_result, right.value.str_val);
-                        
-                        // Langsung set ke result
-                        result.type = TYPE_STRING;
-                        result.value.str_val = str_result;  // Transfer ownership
-                        
-                        // Cleanup input strings jika perlu
-                        if (left.type == TYPE_STRING) free(left.value.str_val);
-                        if (right.type == TYPE_STRING) free(right.value.str_val);
-                    }
-                }
+        case AST_CALL:
+            if (node->slot >= 0) {
+                return call_function(interpreter, node);
             }
-            
-            return result;
-        }
-            
+            return call_builtin(interpreter, node);
+
         case AST_BINARY_OP: {
             Value left = evaluate_expression(interpreter, node->children[0]);
             Value right = evaluate_expression(interpreter, node->children[1]);
             
-            if (left.type == TYPE_INT && right.type == TYPE_INT) {
-                if (strcmp(node->value, "+") == 0) {
-                    result.type = TYPE_INT;
-                    result.value.int_val = left.value.int_val + right.value.int_val;
-                } 
-                else if (strcmp(node->value, "-") == 0) {
-                    result.type = TYPE_INT;
-                    result.value.int_val = left.value.int_val - right.value.int_val;
-                }
-                else if (strcmp(node->value, "*") == 0) {
-                    result.type = TYPE_INT;
-                    result.value.int_val = left.value.int_val * right.value.int_val;
-                }
-                else if (strcmp(node->value, "/") == 0) {
-                    result.type = TYPE_INT;
-                    result.value.int_val = left.value.int_val / right.value.int_val;
-                }
-                // Tambahkan operator perbandingan
-                else if (strcmp(node->value, "<") == 0) {
-                    result.type = TYPE_BOOLEAN;
-                    result.value.bool_val = left.value.int_val < right.value.int_val;
-                }
-                else if (strcmp(node->value, ">") == 0) {
-                    result.type = TYPE_BOOLEAN;
-                    result.value.bool_val = left.value.int_val > right.value.int_val;
-                }
-            }
-            else if (left.type == TYPE_FLOAT && right.type == TYPE_FLOAT) {
-                result.type = TYPE_FLOAT;
-                if (strcmp(node->value, "+") == 0)
-                    result.value.float_val = left.value.float_val + right.value.float_val;
-                else if (strcmp(node->value, "-") == 0)
-                    result.value.float_val = left.value.float_val - right.value.float_val;
-                else if (strcmp(node->value, "*") == 0)
-                    result.value.float_val = left.value.float_val * right.value.float_val;
-                else if (strcmp(node->value, "/") == 0)
-                    result.value.float_val = left.value.float_val / right.value.float_val;
-            }
-            else if (left.type == TYPE_STRING && right.type == TYPE_STRING &&
-                     strcmp(node->value, "+") == 0) {
-                char* str_result = malloc(strlen(left.value.str_val) + strlen(right.value.str_val) + 1);
-                strcpy(str_result, left.value.str_val);
-                strcat(str_result, right.value.str_val);
-                result.type = TYPE_STRING;
-                result.value.str_val = str_result;
+            if (node->op == BINOP_ADD && left.type == TYPE_STRING && right.type == TYPE_STRING) {
+                // left milik kita; hasil antara (a + b) + c bisa tumbuh di tempat
+                append_string(&left, &right);
+                release_value(&right);
+                return left;
             }
+            result = binary_operation(node->op, &left, &right);
+            release_value(&left);
+            release_value(&right);
             break;
         }
         
         case AST_ARRAY_DECL: {
             Value size_val = evaluate_expression(interpreter, node->children[0]);
-            Value* array = create_array_value(size_val.value.int_val);
-            if (array) {
-                result = *array;
-                free(array);
+            if (size_val.type != TYPE_INT) {
+                fprintf(stderr, "Error: Array size must be an integer\n");
+                release_value(&size_val);
+                result.type = TYPE_VOID;
+                break;
             }
+            result = make_array(node->data_type, size_val.value.int_val);
             break;
         }
         
         case AST_ARRAY_ACCESS: {
-            Value* arr = get_variable(interpreter, node->value);
-            if (!arr || arr->type != TYPE_ARRAY_INT) {
+            Value* arr = get_variable(interpreter, node);
+            if (!arr || !is_array_type(arr->type)) {
                 fprintf(stderr, "Error: Invalid array access\n");
                 break;
             }
             
             Value index_val = evaluate_expression(interpreter, node->children[0]);
-            int index = index_val.value.int_val;
-            
-            if (index < 0 || index >= arr->array_size) {
-                fprintf(stderr, "Error: Array index out of bounds\n");
+            if (index_val.type != TYPE_INT) {
+                fprintf(stderr, "Error: Array index must be an integer\n");
+                release_value(&index_val);
                 break;
             }
-            
-            result.type = TYPE_INT;
-            result.value.int_val = arr->value.int_array[index];
+            if (!array_get(arr, index_val.value.int_val, &result)) {
+                fprintf(stderr, "Error: Array index out of bounds\n");
+                result.type = TYPE_INT;
+                result.value.int_val = 0;
+            }
             break;
         }
         
@@ -399,202 +434,209 @@ static Value evaluate_expression(Interpreter* interpreter, ASTNode* node) {
     return result;
 }
 
-// Update fungsi untuk format JSON output
-static void print_formatted_json(const char* json) {
-    int indent = 0;
-    int len = strlen(json);
-    bool in_string = false;
-    
-    for (int i = 0; i < len; i++) {
-        char c = json[i];
-        
-        // Handle string literals
-        if (c == '"' && (i == 0 || json[i-1] != '\\')) {
-            in_string = !in_string;
-            printf("%c", c);
-            continue;
-        }
-        
-        if (!in_string) {
-            switch (c) {
-                case '{':
-                case '[':
-                    printf("%c\n", c);
-                    indent += 2;
-                    for (int j = 0; j < indent; j++) printf(" ");
-                    break;
-                    
-                case '}':
-                case ']':
-                    printf("\n");
-                    indent -= 2;
-                    for (int j = 0; j < indent; j++) printf(" ");
-                    printf("%c", c);
-                    break;
-                    
-                case ',':
-                    printf("%c\n", c);
-                    for (int j = 0; j < indent; j++) printf(" ");
-                    break;
-                    
-                case ':':
-                    printf("%c ", c);
-                    break;
-                    
-                default:
-                    printf("%c", c);
-            }
-        } else {
-            printf("%c", c);
-        }
+static void interpret_call(Interpreter* interpreter, ASTNode* node) {
+    if (node->slot < 0 && node->literal.builtin->id == BUILTIN_CETAK &&
+        node->children[0]->type == AST_STRING) {
+        // Literal sudah didecode; cetak langsung tanpa salinan
+        const char* text = node->children[0]->literal.str_val;
+        print_text(interpreter->out, text, strlen(text));
+    } else {
+        // Pemanggilan sebagai statement; hasilnya dibuang
+        Value result = evaluate_expression(interpreter, node);
+        release_value(&result);
     }
-    printf("\n");
 }
 
-// Update fungsi cetak untuk handle JSON
-static Value evaluate_print(Value arg) {
-    Value result = {0};
-    result.type = TYPE_VOID;
-    
-    switch (arg.type) {
-        case TYPE_STRING:
-        case TYPE_HTTP_RESPONSE:
-            if (arg.value.str_val && 
-                (arg.value.str_val[0] == '{' || arg.value.str_val[0] == '[')) {
-                print_formatted_json(arg.value.str_val);
-            } else {
-                printf("%s\n", arg.value.str_val ? arg.value.str_val : "");
-            }
-            break;
-            
-        case TYPE_INT:
-            printf("%d\n", arg.value.int_val);
-            break;
-            
-        case TYPE_FLOAT:
-            printf("%f\n", arg.value.float_val);
-            break;
-            
-        case TYPE_BOOLEAN:
-            printf("%s\n", arg.value.bool_val ? "benar" : "salah");
-            break;
-            
-        case TYPE_ARRAY_INT:
-            printf("[");
-            for (int i = 0; i < arg.array_size; i++) {
-                printf("%d%s", arg.value.int_array[i], 
-                       i < arg.array_size - 1 ? ", " : "");
-            }
-            printf("]\n");
-            break;
-            
-        case TYPE_ARRAY_FLOAT:
-            printf("[");
-            for (int i = 0; i < arg.array_size; i++) {
-                printf("%f%s", arg.value.float_array[i], 
-                       i < arg.array_size - 1 ? ", " : "");
-            }
-            printf("]\n");
-            break;
-            
-        case TYPE_ARRAY_BOOL:
-            printf("[");
-            for (int i = 0; i < arg.array_size; i++) {
-                printf("%s%s", arg.value.bool_array[i] ? "benar" : "salah", 
-                       i < arg.array_size - 1 ? ", " : "");
-            }
-            printf("]\n");
-            break;
-            
-        case TYPE_ARRAY_STRING:
-            printf("[");
-            for (int i = 0; i < arg.array_size; i++) {
-                printf("\"%s\"%s", arg.value.str_array[i] ? arg.value.str_array[i] : "", 
-                       i < arg.array_size - 1 ? ", " : "");
-            }
-            printf("]\n");
-            break;
-            
-        case TYPE_VOID:
-            printf("void\n");
-            break;
+static bool reads_slot(const ASTNode* node, int slot) {
+    if ((node->type == AST_IDENTIFIER || node->type == AST_ARRAY_ACCESS) && node->slot == slot) {
+        return true;
     }
-    return result;
+    for (int i = 0; i < node->children_count; i++) {
+        if (reads_slot(node->children[i], slot)) return true;
+    }
+    return false;
 }
 
-static void interpret_call(Interpreter* interpreter, ASTNode* node) {
-    if (strcmp(node->value, "cetak") == 0 && node->children_count > 0) {
-        Value expr_val = evaluate_expression(interpreter, node->children[0]);
-        evaluate_print(expr_val);
-        // Hanya free jika tipe data memerlukan free
-        if (expr_val.type == TYPE_STRING || expr_val.type == TYPE_HTTP_RESPONSE) {
-            free(expr_val.value.str_val);
-        }
-    } else if (strcmp(node->value, "http_get") == 0) {
-        Value url_val = evaluate_expression(interpreter, node->children[0]);
-        if (url_val.type == TYPE_STRING) {
-            Value result = evaluate_http_get(url_val.value.str_val);
-            evaluate_print(result);
-            // Free string hasil HTTP request
-            if (result.value.str_val) {
-                free(result.value.str_val);
-            }
-            // Free URL
-            if (url_val.value.str_val) {
-                free(url_val.value.str_val);
-            }
-        }
-    } else if (strcmp(node->value, "http_post") == 0) {
-        Value url_val = evaluate_expression(interpreter, node->children[0]);
-        Value data_val = evaluate_expression(interpreter, node->children[1]);
-        if (url_val.type == TYPE_STRING && data_val.type == TYPE_STRING) {
-            Value result = evaluate_http_post(url_val.value.str_val, data_val.value.str_val);
-            evaluate_print(result);
-            // Free string hasil HTTP request
-            if (result.value.str_val) {
-                free(result.value.str_val);
-            }
-            // Free URL dan data
-            if (url_val.value.str_val) {
-                free(url_val.value.str_val);
-            }
-            if (data_val.value.str_val) {
-                free(data_val.value.str_val);
-            }
+// true kalau expr berbentuk target + a + b ... dengan target di ujung kiri
+// dan operand kanan tidak membaca target (nilainya berubah di tengah jalan)
+static bool is_append_chain(ASTNode* expr, ASTNode* target) {
+    while (expr->type == AST_BINARY_OP && expr->op == BINOP_ADD) {
+        if (reads_slot(expr->children[1], target->slot)) return false;
+        expr = expr->children[0];
+    }
+    return expr->type == AST_IDENTIFIER && expr->slot == target->slot;
+}
+
+// Tambahkan operand kanan rangkaian satu per satu langsung ke slot, jadi
+// String yang hanya dimiliki slot tumbuh di tempat
+static void append_chain(Interpreter* interpreter, int slot, ASTNode* expr) {
+    if (expr->type != AST_BINARY_OP) return;
+    append_chain(interpreter, slot, expr->children[0]);
+
+    Value right = evaluate_expression(interpreter, expr->children[1]);
+    // Ambil setelah evaluasi; callback bisa memperbesar array slot
+    Value* var = &interpreter->frame[slot].value;
+    if (var->type == TYPE_STRING && right.type == TYPE_STRING) {
+        append_string(var, &right);
+    } else {
+        Value result = binary_operation(BINOP_ADD, var, &right);
+        release_value(var);
+        *var = result;
+    }
+    release_value(&right);
+}
+
+static void assign(Interpreter* interpreter, ASTNode* node) {
+    if (node->children_count == 0) return;
+
+    ASTNode* expr = node->children[0];
+    if (expr->type == AST_BINARY_OP && is_append_chain(expr, node)) {
+        Variable* var = node->slot >= 0 ? &interpreter->frame[node->slot] : NULL;
+        if (var && var->defined && var->value.type == TYPE_STRING) {
+            append_chain(interpreter, node->slot, expr);
+            return;
         }
     }
+    set_variable(interpreter, node, evaluate_expression(interpreter, expr));
 }
 
-// Update fungsi interpret_variable_decl
 static void interpret_variable_decl(Interpreter* interpreter, ASTNode* node) {
-    if (node->children_count > 0) {
-        Value expr_val = evaluate_expression(interpreter, node->children[0]);
-        Value* value = malloc(sizeof(Value));
-        *value = expr_val;  // Copy value
-        set_variable(interpreter, node->value, value);
-    }
+    assign(interpreter, node);
 }
 
-// Update fungsi interpret_assignment
 static void interpret_assignment(Interpreter* interpreter, ASTNode* node) {
-    if (node->children_count > 0) {
-        Value expr_val = evaluate_expression(interpreter, node->children[0]);
-        Value* value = malloc(sizeof(Value));
-        *value = expr_val;  // Copy value
-        set_variable(interpreter, node->value, value);
-    }
+    assign(interpreter, node);
 }
 
 static void interpret_block(Interpreter* interpreter, ASTNode* node) {
-    for (int i = 0; i < node->children_count; i++) {
+    for (int i = 0; i < node->children_count && !interpreter->returning; i++) {
         interpret(interpreter, node->children[i]);
     }
 }
 
-static void interpret_function(Interpreter* interpreter, ASTNode* node) {
+// kembali f(...): argumen dihitung di atas frame, lalu run_frame
+// menjalankan f di frame ini tanpa menambah kedalaman
+static void tail_call(Interpreter* interpreter, ASTNode* call) {
+    ASTNode* function = interpreter->program->children[call->slot];
+    int argc = call->children_count;
+    if (interpreter->stack_top + argc > interpreter->stack_capacity) {
+        stack_exhausted(interpreter, function);
+        return;
+    }
+
+    // Pemanggilan di dalam argumen memakai stack di atas argumen
+    Variable* args = &interpreter->stack[interpreter->stack_top];
+    interpreter->stack_top += argc;
+    if (interpreter->stack_top > interpreter->stack_used) {
+        interpreter->stack_used = interpreter->stack_top;
+    }
+    for (int i = 0; i < argc; i++) {
+        args[i].value = evaluate_expression(interpreter, call->children[i]);
+        args[i].defined = true;
+    }
+    interpreter->stack_top -= argc;
+
+    if (interpreter->aborted) {
+        for (int i = 0; i < argc; i++) {
+            release_value(&args[i].value);
+            args[i].defined = false;
+        }
+        return;
+    }
+    interpreter->tail_function = function;
+    interpreter->tail_argc = argc;
+    interpreter->returning = true;
+}
+
+static void interpret_return(Interpreter* interpreter, ASTNode* node) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (node->children_count > 0 && node->children[0]->type == AST_CALL &&
+        node->children[0]->slot >= 0) {
+        tail_call(interpreter, node->children[0]);
+        return;
+    }
     if (node->children_count > 0) {
-        interpret(interpreter, node->children[0]);
+        result = evaluate_expression(interpreter, node->children[0]);
+    }
+    // Error fatal saat evaluasi: frame sedang dibongkar, hasilnya dibuang
+    if (interpreter->aborted) {
+        release_value(&result);
+        return;
+    }
+    release_value(&interpreter->return_value);
+    interpreter->return_value = result;
+    interpreter->returning = true;
+}
+
+// main dijalankan di frame pertama, yang baru dilepas free_interpreter
+static void run_main(Interpreter* interpreter) {
+    ASTNode* main_function = find_function(interpreter->program, "main");
+    char stack_base;
+    interpreter->c_stack_base = &stack_base;
+    interpreter->aborted = false;
+    Variable* frame = push_frame(interpreter, main_function);
+    if (frame) {
+        Value result = run_frame(interpreter, main_function, frame);
+        release_value(&result);
+    }
+    interpreter->returning = false;
+    interpreter->c_stack_base = NULL;
+}
+
+static void* run_main_thread(void* data) {
+    run_main(data);
+    return NULL;
+}
+
+// Entry point program. Stack slot dan stack C disediakan untuk max_depth,
+// jadi batas kedalaman sama dengan VM.
+static void interpret_program(Interpreter* interpreter, ASTNode* node) {
+    interpreter->program = node;
+    if (!find_function(node, "main")) {
+        fprintf(stderr, "Error: Function 'main' not found\n");
+        return;
+    }
+
+    if (!interpreter->stack) {
+        size_t capacity = (size_t)interpreter->max_depth * INTERPRETER_FRAME_RESERVE;
+        if (capacity < INTERPRETER_STACK_SIZE) capacity = INTERPRETER_STACK_SIZE;
+        if (capacity > INT_MAX) capacity = INT_MAX;
+        interpreter->stack = calloc(capacity, sizeof(Variable));
+        interpreter->stack_capacity = interpreter->stack ? (int)capacity : 0;
+        interpreter->frame = interpreter->stack;
+    }
+    if (!interpreter->stack) {
+        fprintf(stderr, "Error: Stack untuk %d pemanggilan tidak bisa dialokasikan\n",
+                interpreter->max_depth);
+        return;
+    }
+
+    size_t needed = (size_t)interpreter->max_depth * INTERPRETER_C_FRAME_RESERVE;
+    if (needed <= interpreter->c_stack_budget) {
+        run_main(interpreter);
+        return;
+    }
+
+    // Stack proses terlalu kecil: thread baru dengan budget sebesar
+    // kebutuhan max_depth, ditambah sisa yang sama untuk builtin
+    size_t budget = interpreter->c_stack_budget;
+    pthread_attr_t attr;
+    pthread_t thread;
+    bool started = false;
+    if (pthread_attr_init(&attr) == 0) {
+        interpreter->c_stack_budget = needed;
+        started = pthread_attr_setstacksize(&attr, needed + budget) == 0 &&
+                  pthread_create(&thread, &attr, run_main_thread, interpreter) == 0;
+        pthread_attr_destroy(&attr);
+    }
+    if (started) {
+        pthread_join(thread, NULL);
+    } else {
+        fprintf(stderr, "Error: Stack untuk %d pemanggilan tidak bisa dialokasikan\n",
+                interpreter->max_depth);
     }
+    interpreter->c_stack_budget = budget;
 }
 
 static void interpret_if(Interpreter* interpreter, ASTNode* node) {
@@ -602,7 +644,13 @@ static void interpret_if(Interpreter* interpreter, ASTNode* node) {
         ASTNode* condition = node->children[0];
         ASTNode* body = node->children[1];
         
-        if (evaluate_expression(interpreter, condition).value.bool_val) {
+        Value value = evaluate_expression(interpreter, condition);
+        if (value.type != TYPE_BOOLEAN) {
+            fprintf(stderr, "Error: If condition must be boolean\n");
+            release_value(&value);
+            return;
+        }
+        if (value.value.bool_val) {
             interpret(interpreter, body);
         }
     }
@@ -611,11 +659,12 @@ static void interpret_if(Interpreter* interpreter, ASTNode* node) {
 static void interpret_while(Interpreter* interpreter, ASTNode* node) {
     if (node->children_count < 2) return;
     
-    while (1) {
+    while (!interrupted(interpreter)) {
         // Evaluasi kondisi
         Value condition = evaluate_expression(interpreter, node->children[0]);
         if (condition.type != TYPE_BOOLEAN) {
             fprintf(stderr, "Error: While condition must be boolean\n");
+            release_value(&condition);
             return;
         }
         
@@ -623,6 +672,7 @@ static void interpret_while(Interpreter* interpreter, ASTNode* node) {
         
         // Eksekusi body
         interpret_block(interpreter, node->children[1]);
+        if (interpreter->returning) break;
     }
 }
 
@@ -631,13 +681,11 @@ void interpret(Interpreter* interpreter, ASTNode* node) {
 
     switch (node->type) {
         case AST_PROGRAM:
-            for (int i = 0; i < node->children_count; i++) {
-                interpret(interpreter, node->children[i]);
-            }
+            interpret_program(interpreter, node);
             break;
             
-        case AST_FUNCTION:
-            interpret_function(interpreter, node);
+        case AST_RETURN:
+            interpret_return(interpreter, node);
             break;
             
         case AST_BLOCK:
@@ -672,132 +720,3 @@ void interpret(Interpreter* interpreter, ASTNode* node) {
             break;
     }
 }
-
-Value* create_array(DataType type, int size) {
-    Value* arr = malloc(sizeof(Value));
-    arr->type = type;
-    arr->array_size = size;
-    
-    switch(type) {
-        case TYPE_ARRAY_INT:
-            arr->value.int_array = calloc(size, sizeof(int));
-            break;
-        case TYPE_ARRAY_FLOAT:
-            arr->value.float_array = calloc(size, sizeof(float));
-            break;
-        case TYPE_ARRAY_BOOL:
-            arr->value.bool_array = calloc(size, sizeof(int));
-            break;
-        case TYPE_ARRAY_STRING:
-            arr->value.str_array = calloc(size, sizeof(char*));
-            break;
-        default:
-            free(arr);
-            return NULL;
-    }
-    return arr;
-}
-
-// Fungsi untuk mengakses array
-Value* array_get(Value* arr, int index) {
-    if (!arr || index < 0 || index >= arr->array_size) {
-        return NULL;
-    }
-    
-    Value* result = malloc(sizeof(Value));
-    result->type = arr->type;
-    result->array_size = 0;
-    
-    switch(arr->type) {
-        case TYPE_ARRAY_INT:
-            result->type = TYPE_INT;
-            result->value.int_val = arr->value.int_array[index];
-            break;
-        case TYPE_ARRAY_FLOAT:
-            result->type = TYPE_FLOAT;
-            result->value.float_val = arr->value.float_array[index];
-            break;
-        case TYPE_ARRAY_BOOL:
-            result->type = TYPE_BOOLEAN;
-            result->value.bool_val = arr->value.bool_array[index];
-            break;
-        case TYPE_ARRAY_STRING:
-            result->type = TYPE_STRING;
-            result->value.str_val = strdup(arr->value.str_array[index] ? 
-                                         arr->value.str_array[index] : "");
-            break;
-        default:
-            free(result);
-            return NULL;
-    }
-    return result;
-}
-
-// Fungsi untuk mengubah nilai array
-bool array_set(Value* arr, int index, Value* value) {
-    if (!arr || !value || index < 0 || index >= arr->array_size) {
-        return false;
-    }
-    
-    switch(arr->type) {
-        case TYPE_ARRAY_INT:
-            if (value->type != TYPE_INT) return false;
-            arr->value.int_array[index] = value->value.int_val;
-            break;
-        case TYPE_ARRAY_FLOAT:
-            if (value->type != TYPE_FLOAT) return false;
-            arr->value.float_array[index] = value->value.float_val;
-            break;
-        case TYPE_ARRAY_BOOL:
-            if (value->type != TYPE_BOOLEAN) return false;
-            arr->value.bool_array[index] = value->value.bool_val;
-            break;
-        case TYPE_ARRAY_STRING:
-            if (value->type != TYPE_STRING) return false;
-            if (arr->value.str_array[index]) {
-                free(arr->value.str_array[index]);
-            }
-            arr->value.str_array[index] = strdup(value->value.str_val);
-            break;
-        default:
-            return false;
-    }
-    return true;
-}
-
-void free_value(Value* value) {
-    if (!value) return;
-    
-    switch(value->type) {
-        case TYPE_STRING:
-        case TYPE_HTTP_RESPONSE:  // Handle sama seperti string
-            if (value->value.str_val) free(value->value.str_val);
-            break;
-        case TYPE_ARRAY_INT:
-            if (value->value.int_array) free(value->value.int_array);
-            break;
-        case TYPE_ARRAY_FLOAT:
-            if (value->value.float_array) free(value->value.float_array);
-            break;
-        case TYPE_ARRAY_STRING:
-            if (value->value.str_array) {
-                for (int i = 0; i < value->array_size; i++) {
-                    if (value->value.str_array[i]) {
-                        free(value->value.str_array[i]);
-                    }
-                }
-                free(value->value.str_array);
-            }
-            break;
-        case TYPE_ARRAY_BOOL:
-            if (value->value.bool_array) free(value->value.bool_array);
-            break;
-        // Primitive types don't need cleanup
-        case TYPE_INT:
-        case TYPE_FLOAT:
-        case TYPE_BOOLEAN:
-        case TYPE_VOID:
-            break;
-    }
-    free(value);
-} 
\ No newline at end of file
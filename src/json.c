@@ -0,0 +1,430 @@
+#include "json.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---- Tahap 1: indeks struktural ----
+
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+// Bit tinggi menyala pada byte word yang sama dengan c
+static inline uint64_t has_byte(uint64_t word, uint8_t c) {
+    uint64_t x = word ^ (ONES * c);
+    return (x - ONES) & ~x & HIGHS;
+}
+
+// Posisi setelah kutip penutup string yang isinya mulai di pos; isi string
+// dilewati delapan byte sekaligus selama tidak ada '"' atau '\'.
+// Mengembalikan 0 kalau string tidak ditutup.
+static size_t skip_string(const char* text, size_t length, size_t pos) {
+    for (;;) {
+        while (pos + 8 <= length) {
+            uint64_t word;
+            memcpy(&word, text + pos, 8);
+            if (has_byte(word, '"') | has_byte(word, '\\')) break;
+            pos += 8;
+        }
+        if (pos >= length) return 0;
+
+        char c = text[pos];
+        if (c == '"') return pos + 1;
+        pos += c == '\\' ? 2 : 1;
+    }
+}
+
+static bool is_delimiter(char c) {
+    switch (c) {
+        case '{': case '}': case '[': case ']': case ':': case ',':
+        case ' ': case '\t': case '\n': case '\r': case '"':
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool add_structural(JsonDocument* doc, int* capacity, size_t pos) {
+    if (doc->count == *capacity) {
+        *capacity *= 2;
+        uint32_t* structurals = realloc(doc->structurals, *capacity * sizeof(uint32_t));
+        if (!structurals) return false;
+        doc->structurals = structurals;
+        uint32_t* matches = realloc(doc->matches, *capacity * sizeof(uint32_t));
+        if (!matches) return false;
+        doc->matches = matches;
+    }
+    doc->structurals[doc->count] = (uint32_t)pos;
+    doc->matches[doc->count] = 0;
+    doc->count++;
+    return true;
+}
+
+static bool build_index(JsonDocument* doc) {
+    const char* text = doc->text;
+    size_t length = doc->length;
+
+    int capacity = (int)(length / 4) + 16;
+    doc->structurals = malloc(capacity * sizeof(uint32_t));
+    doc->matches = malloc(capacity * sizeof(uint32_t));
+
+    int stack_capacity = 64;
+    int depth = 0;
+    int* stack = malloc(stack_capacity * sizeof(int));
+    if (!doc->structurals || !doc->matches || !stack) {
+        free(stack);
+        return false;
+    }
+
+    bool ok = true;
+    size_t pos = 0;
+    while (ok && pos < length) {
+        char c = text[pos];
+        switch (c) {
+            case ' ': case '\t': case '\n': case '\r':
+                pos++;
+                break;
+
+            case '{':
+            case '[':
+                if (depth == stack_capacity) {
+                    int* grown = realloc(stack, stack_capacity * 2 * sizeof(int));
+                    if (!grown) { ok = false; break; }
+                    stack = grown;
+                    stack_capacity *= 2;
+                }
+                stack[depth++] = doc->count;
+                ok = add_structural(doc, &capacity, pos++);
+                break;
+
+            case '}':
+            case ']': {
+                if (depth == 0) { ok = false; break; }
+                int open = stack[--depth];
+                char expected = c == '}' ? '{' : '[';
+                if (text[doc->structurals[open]] != expected) { ok = false; break; }
+                doc->matches[open] = (uint32_t)doc->count;
+                ok = add_structural(doc, &capacity, pos++);
+                break;
+            }
+
+            case ':':
+            case ',':
+                ok = add_structural(doc, &capacity, pos++);
+                break;
+
+            case '"':
+                ok = add_structural(doc, &capacity, pos);
+                pos = skip_string(text, length, pos + 1);
+                if (pos == 0) ok = false;
+                break;
+
+            default:
+                // Awal angka/true/false/null; isinya diurai saat diakses
+                ok = add_structural(doc, &capacity, pos);
+                while (pos < length && !is_delimiter(text[pos])) pos++;
+                break;
+        }
+    }
+
+    free(stack);
+    return ok && depth == 0 && doc->count > 0;
+}
+
+JsonDocument* json_parse(char* text, size_t length) {
+    JsonDocument* doc = calloc(1, sizeof(JsonDocument));
+    if (!doc) {
+        free(text);
+        return NULL;
+    }
+    value_heap_allocations++;
+    doc->refcount = 1;
+    doc->text = text;
+    doc->length = length;
+
+    if (!build_index(doc)) {
+        json_release(doc);
+        return NULL;
+    }
+    return doc;
+}
+
+void json_retain(JsonDocument* doc) {
+    if (doc) doc->refcount++;
+}
+
+void json_release(JsonDocument* doc) {
+    if (!doc || --doc->refcount > 0) return;
+    free(doc->structurals);
+    free(doc->matches);
+    free(doc->text);
+    free(doc);
+}
+
+// ---- Tahap 2: akses on-demand ----
+
+// '\0' di luar indeks, supaya JSON yang rusak tidak dibaca melewati batas
+static inline char structural_char(const JsonDocument* doc, int index) {
+    return index < doc->count ? doc->text[doc->structurals[index]] : '\0';
+}
+
+// Index struktural setelah nilai di index; object/array dilompati utuh
+static inline int skip_value(const JsonDocument* doc, int index) {
+    char c = structural_char(doc, index);
+    return (c == '{' || c == '[') ? (int)doc->matches[index] + 1 : index + 1;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static unsigned parse_hex4(const char* p) {
+    unsigned code = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hex_value(p[i]);
+        if (digit < 0) return 0xFFFD;
+        code = code << 4 | (unsigned)digit;
+    }
+    return code;
+}
+
+static char* encode_utf8(char* out, unsigned code) {
+    if (code < 0x80) {
+        *out++ = (char)code;
+    } else if (code < 0x800) {
+        *out++ = (char)(0xC0 | code >> 6);
+        *out++ = (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        *out++ = (char)(0xE0 | code >> 12);
+        *out++ = (char)(0x80 | (code >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | code >> 18);
+        *out++ = (char)(0x80 | (code >> 12 & 0x3F));
+        *out++ = (char)(0x80 | (code >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+// Decode string JSON yang kutip pembukanya di start; hasil malloc
+static char* decode_string(const JsonDocument* doc, size_t start) {
+    const char* p = doc->text + start + 1;
+    const char* end = doc->text + skip_string(doc->text, doc->length, start + 1) - 1;
+
+    // Hasil decode tidak pernah lebih panjang dari teks mentahnya
+    char* result = malloc(end - p + 1);
+    char* out = result;
+
+    while (p < end) {
+        if (*p != '\\') {
+            *out++ = *p++;
+            continue;
+        }
+        p++;
+        switch (*p++) {
+            case 'n': *out++ = '\n'; break;
+            case 't': *out++ = '\t'; break;
+            case 'r': *out++ = '\r'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'u': {
+                if (end - p < 4) break;
+                unsigned code = parse_hex4(p);
+                p += 4;
+                // Surrogate pair menjadi satu code point
+                if (code >= 0xD800 && code < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    unsigned low = parse_hex4(p + 2);
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    }
+                }
+                out = encode_utf8(out, code);
+                break;
+            }
+            default: *out++ = p[-1]; break;  // \" \\ \/
+        }
+    }
+    *out = '\0';
+    return result;
+}
+
+static Value materialize(JsonDocument* doc, int index) {
+    Value result = {0};
+    size_t pos = doc->structurals[index];
+    const char* p = doc->text + pos;
+
+    switch (*p) {
+        case '{':
+        case '[':
+            json_retain(doc);
+            result.type = TYPE_JSON;
+            result.value.json.doc = doc;
+            result.value.json.index = index;
+            break;
+
+        case '"': {
+            char* decoded = decode_string(doc, pos);
+            result = adopt_string(decoded, strlen(decoded));
+            break;
+        }
+
+        case 't':
+        case 'f':
+            result.type = TYPE_BOOLEAN;
+            result.value.bool_val = *p == 't';
+            break;
+
+        case 'n':
+            result.type = TYPE_VOID;
+            break;
+
+        default: {
+            const char* end = p;
+            bool is_float = false;
+            while (*end && !is_delimiter(*end)) {
+                if (*end == '.' || *end == 'e' || *end == 'E') is_float = true;
+                end++;
+            }
+            if (is_float) {
+                result.type = TYPE_FLOAT;
+                result.value.float_val = strtof(p, NULL);
+            } else {
+                result.type = TYPE_INT;
+                result.value.int_val = (int)strtol(p, NULL, 10);
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+// Bandingkan key mentah di index dengan key; escape jarang, jadi
+// decode hanya dilakukan kalau key mengandung '\'
+static bool key_equals(const JsonDocument* doc, int index, const char* key, size_t key_length) {
+    size_t start = doc->structurals[index];
+    const char* raw = doc->text + start + 1;
+    size_t raw_length = doc->structurals[index + 1] - start - 1;  // Sampai sebelum ':'
+
+    const char* quote = memchr(raw, '"', raw_length);
+    const char* escape = memchr(raw, '\\', raw_length);
+    if (!escape || (quote && quote < escape)) {
+        return quote && (size_t)(quote - raw) == key_length && memcmp(raw, key, key_length) == 0;
+    }
+
+    char* decoded = decode_string(doc, start);
+    bool equal = strcmp(decoded, key) == 0;
+    free(decoded);
+    return equal;
+}
+
+Value json_root(JsonDocument* doc) {
+    return materialize(doc, 0);
+}
+
+Value json_get_field(const Value* json, const char* key) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (json->type != TYPE_JSON) return result;
+
+    JsonDocument* doc = json->value.json.doc;
+    int index = json->value.json.index;
+    if (structural_char(doc, index) != '{') return result;
+
+    size_t key_length = strlen(key);
+    int i = index + 1;
+    while (structural_char(doc, i) == '"') {
+        if (structural_char(doc, i + 1) != ':') break;
+        if (key_equals(doc, i, key, key_length)) {
+            return materialize(doc, i + 2);
+        }
+        i = skip_value(doc, i + 2);
+        if (structural_char(doc, i) != ',') break;
+        i++;
+    }
+    return result;
+}
+
+Value json_get_index(const Value* json, int index) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (json->type != TYPE_JSON || index < 0) return result;
+
+    JsonDocument* doc = json->value.json.doc;
+    int open = json->value.json.index;
+    if (structural_char(doc, open) != '[') return result;
+
+    int end = (int)doc->matches[open];
+    int i = open + 1;
+    for (int n = 0; i < end; n++) {
+        if (n == index) return materialize(doc, i);
+        i = skip_value(doc, i);
+        if (structural_char(doc, i) != ',') break;
+        i++;
+    }
+    return result;
+}
+
+int json_length(const Value* json) {
+    if (json->type != TYPE_JSON) return 0;
+
+    JsonDocument* doc = json->value.json.doc;
+    int open = json->value.json.index;
+    bool is_object = structural_char(doc, open) == '{';
+    int end = (int)doc->matches[open];
+
+    int count = 0;
+    int i = open + 1;
+    while (i < end) {
+        count++;
+        // Object: lewati key dan ':' dulu
+        if (is_object) i += 2;
+        i = skip_value(doc, i);
+        if (structural_char(doc, i) != ',') break;
+        i++;
+    }
+    return count;
+}
+
+const char* json_text(const Value* json, size_t* length) {
+    JsonDocument* doc = json->value.json.doc;
+    int open = json->value.json.index;
+    size_t start = doc->structurals[open];
+    size_t end = doc->structurals[doc->matches[open]];
+    *length = end - start + 1;
+    return doc->text + start;
+}
+
+Value json_parse_value(Value* text) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (text->type != TYPE_STRING) return result;
+
+    // Dokumen butuh buffer sendiri; isi String bisa dipakai bersama
+    size_t length = value_strlen(text);
+    char* source = malloc(length + 1);
+    if (source) memcpy(source, value_cstr(text), length + 1);
+    release_value(text);
+    if (!source) return result;
+
+    JsonDocument* doc = json_parse(source, length);
+    if (!doc) {
+        fprintf(stderr, "Error: Invalid JSON\n");
+        return result;
+    }
+    result = json_root(doc);
+    json_release(doc);
+    return result;
+}
+
+Value json_access(const Value* json, const Value* key) {
+    if (key->type == TYPE_STRING) return json_get_field(json, value_cstr(key));
+    if (key->type == TYPE_INT) return json_get_index(json, key->value.int_val);
+
+    Value result = {0};
+    result.type = TYPE_VOID;
+    return result;
+}
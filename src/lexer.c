@@ -4,16 +4,14 @@
 #include <stdbool.h>
 #include "lexer.h"
 
-Lexer* create_lexer(const char* source) {
+Lexer* create_lexer(const char* source, int length) {
+    if (!source || length < 0) return NULL;
+
     Lexer* lexer = (Lexer*)malloc(sizeof(Lexer));
     if (!lexer) return NULL;
 
-    lexer->source = strdup(source);
-    if (!lexer->source) {
-        free(lexer);
-        return NULL;
-    }
-
+    lexer->source = source;
+    lexer->length = length;
     lexer->position = 0;
     lexer->line = 1;
     lexer->column = 1;
@@ -21,13 +19,18 @@ Lexer* create_lexer(const char* source) {
 }
 
 void free_lexer(Lexer* lexer) {
-    if (lexer) {
-        if (lexer->source) free(lexer->source);
-        free(lexer);
-    }
+    free(lexer);
+}
+
+const char* token_text(const Lexer* lexer, const Token* token) {
+    return lexer->source + token->start;
 }
 
+// Semua pengecekan batas memakai length, bukan '\0' atau strlen
 static char peek(Lexer* lexer) {
+    if (lexer->position >= lexer->length) {
+        return '\0';
+    }
     return lexer->source[lexer->position];
 }
 
@@ -44,7 +47,7 @@ static char advance(Lexer* lexer) {
 }
 
 static char peek_next(Lexer* lexer) {
-    if ((size_t)lexer->position + 1 >= strlen(lexer->source)) {
+    if (lexer->position + 1 >= lexer->length) {
         return '\0';
     }
     return lexer->source[lexer->position + 1];
@@ -71,7 +74,89 @@ static void skip_whitespace_and_comments(Lexer* lexer) {
     }
 }
 
-static Token* read_identifier(Lexer* lexer) {
+// Keyword dicari lewat switch panjang lalu huruf pertama, jadi identifier
+// biasa umumnya ditolak tanpa satu pun perbandingan string.
+TokenType lookup_keyword(const char* text, int length) {
+    switch (length) {
+        case 3:
+            switch (text[0]) {
+                case 'i':
+                    if (memcmp(text, "int", 3) == 0) return TOKEN_TYPE_INT;
+                    if (memcmp(text, "isi", 3) == 0) return TOKEN_ISI;
+                    break;
+                case 's':
+                    if (memcmp(text, "str", 3) == 0) return TOKEN_TYPE_STR;
+                    break;
+            }
+            break;
+
+        case 4:
+            switch (text[0]) {
+                case 'b':
+                    if (memcmp(text, "bool", 4) == 0) return TOKEN_TYPE_BOOL;
+                    break;
+                case 'k':
+                    if (memcmp(text, "kalo", 4) == 0) return TOKEN_KALO;
+                    break;
+                case 'm':
+                    if (memcmp(text, "maka", 4) == 0) return TOKEN_MAKA;
+                    break;
+                case 'l':
+                    if (memcmp(text, "lain", 4) == 0) return TOKEN_LAIN;
+                    break;
+            }
+            break;
+
+        case 5:
+            switch (text[0]) {
+                case 'a':
+                    if (memcmp(text, "array", 5) == 0) return TOKEN_ARRAY;
+                    break;
+                case 'b':
+                    if (memcmp(text, "bikin", 5) == 0) return TOKEN_BIKIN;
+                    if (memcmp(text, "benar", 5) == 0) return TOKEN_BENAR;
+                    break;
+                case 'c':
+                    if (memcmp(text, "cetak", 5) == 0) return TOKEN_CETAK;
+                    break;
+                case 'f':
+                    if (memcmp(text, "float", 5) == 0) return TOKEN_TYPE_FLOAT;
+                    break;
+                case 's':
+                    if (memcmp(text, "salah", 5) == 0) return TOKEN_SALAH;
+                    break;
+                case 'u':
+                    if (memcmp(text, "ulang", 5) == 0) return TOKEN_ULANG;
+                    break;
+            }
+            break;
+
+        case 6:
+            if (memcmp(text, "fungsi", 6) == 0) return TOKEN_FUNGSI;
+            if (memcmp(text, "sampai", 6) == 0) return TOKEN_SAMPAI;
+            break;
+
+        case 7:
+            if (memcmp(text, "kembali", 7) == 0) return TOKEN_KEMBALI;
+            break;
+
+        case 10:
+            if (memcmp(text, "fungsi_int", 10) == 0) return TOKEN_FUNGSI_INT;
+            if (memcmp(text, "fungsi_str", 10) == 0) return TOKEN_FUNGSI_STR;
+            break;
+
+        case 11:
+            if (memcmp(text, "fungsi_bool", 11) == 0) return TOKEN_FUNGSI_BOOL;
+            break;
+
+        case 12:
+            if (memcmp(text, "fungsi_float", 12) == 0) return TOKEN_FUNGSI_FLOAT;
+            break;
+    }
+    return TOKEN_IDENTIFIER;
+}
+
+static Token read_identifier(Lexer* lexer) {
     int start_pos = lexer->position;
     int start_col = lexer->column;
     
@@ -80,40 +165,11 @@ static Token* read_identifier(Lexer* lexer) {
     }
     
     int length = lexer->position - start_pos;
-    char* value = (char*)malloc(length + 1);
-    strncpy(value, &lexer->source[start_pos], length);
-    value[length] = '\0';
-    
-    // Check for keywords
-    TokenType type = TOKEN_IDENTIFIER;
-    if (strcmp(value, "bikin") == 0) type = TOKEN_BIKIN;
-    else if (strcmp(value, "fungsi_int") == 0) type = TOKEN_FUNGSI_INT;
-    else if (strcmp(value, "fungsi_float") == 0) type = TOKEN_FUNGSI_FLOAT;
-    else if (strcmp(value, "fungsi_bool") == 0) type = TOKEN_FUNGSI_BOOL;
-    else if (strcmp(value, "fungsi_str") == 0) type = TOKEN_FUNGSI_STR;
-    else if (strcmp(value, "int") == 0) type = TOKEN_TYPE_INT;
-    else if (strcmp(value, "float") == 0) type = TOKEN_TYPE_FLOAT;
-    else if (strcmp(value, "bool") == 0) type = TOKEN_TYPE_BOOL;
-    else if (strcmp(value, "str") == 0) type = TOKEN_TYPE_STR;
-    else if (strcmp(value, "cetak") == 0) type = TOKEN_CETAK;
-    else if (strcmp(value, "kalo") == 0) type = TOKEN_KALO;
-    else if (strcmp(value, "maka") == 0) type = TOKEN_MAKA;
-    else if (strcmp(value, "lain") == 0) type = TOKEN_LAIN;
-    else if (strcmp(value, "ulang") == 0) type = TOKEN_ULANG;
-    else if (strcmp(value, "sampai") == 0) type = TOKEN_SAMPAI;
-    else if (strcmp(value, "fungsi") == 0) type = TOKEN_FUNGSI;
-    else if (strcmp(value, "kembali") == 0) type = TOKEN_KEMBALI;
-    else if (strcmp(value, "isi") == 0) type = TOKEN_ISI;
-    else if (strcmp(value, "benar") == 0) type = TOKEN_BENAR;
-    else if (strcmp(value, "salah") == 0) type = TOKEN_SALAH;
-    else if (strcmp(value, "array") == 0) type = TOKEN_ARRAY;
-    
-    Token* token = create_token(type, value, lexer->line, start_col);
-    free(value);
-    return token;
+    TokenType type = lookup_keyword(&lexer->source[start_pos], length);
+    return create_token(type, start_pos, length, lexer->line, start_col);
 }
 
-static Token* read_number(Lexer* lexer) {
+static Token read_number(Lexer* lexer) {
     int start_pos = lexer->position;
     int start_col = lexer->column;
     bool is_float = false;
@@ -126,40 +182,34 @@ static Token* read_number(Lexer* lexer) {
         advance(lexer);
     }
     
-    int length = lexer->position - start_pos;
-    char* value = (char*)malloc(length + 1);
-    strncpy(value, &lexer->source[start_pos], length);
-    value[length] = '\0';
-    
-    Token* token = create_token(
+    return create_token(
         is_float ? TOKEN_FLOAT : TOKEN_NUMBER,
-        value,
+        start_pos,
+        lexer->position - start_pos,
         lexer->line,
         start_col
     );
-    free(value);
-    return token;
 }
 
-Token* get_next_token(Lexer* lexer) {
+Token get_next_token(Lexer* lexer) {
     if (!lexer || !lexer->source) {
-        return NULL;
+        return create_token(TOKEN_EOF, 0, 0, 0, 0);
     }
 
-    size_t source_len = strlen(lexer->source);
-    if ((size_t)lexer->position >= source_len) {
-        return NULL;
+    if (lexer->position >= lexer->length) {
+        return create_token(TOKEN_EOF, lexer->position, 0, lexer->line, lexer->column);
     }
 
     skip_whitespace_and_comments(lexer);
     
     char c = peek(lexer);
+    int current_pos = lexer->position;
     int current_line = lexer->line;
     int current_col = lexer->column;
     
     // End of file
     if (c == '\0') {
-        return NULL;
+        return create_token(TOKEN_EOF, current_pos, 0, current_line, current_col);
     }
     
     // Identifiers dan keywords
@@ -179,45 +229,72 @@ Token* get_next_token(Lexer* lexer) {
         int start_col = lexer->column;
         
         while (peek(lexer) != '"' && peek(lexer) != '\0') {
+            // \" tidak menutup string; escape-nya diproses process_string
+            if (peek(lexer) == '\\' && peek_next(lexer) != '\0') {
+                advance(lexer);
+            }
             advance(lexer);
         }
         
         if (peek(lexer) == '"') {
             int length = lexer->position - start_pos;
-            char* value = (char*)malloc(length + 1);
-            strncpy(value, &lexer->source[start_pos], length);
-            value[length] = '\0';
             advance(lexer); // Skip closing quote
-            
-            Token* token = create_token(TOKEN_STRING, value, current_line, start_col);
-            free(value);
-            return token;
+            return create_token(TOKEN_STRING, start_pos, length, current_line, start_col);
         }
-        return NULL;  // Unterminated string
+        // Unterminated string
+        return create_token(TOKEN_EOF, current_pos, 0, current_line, current_col);
     }
     
     // Single character tokens
     advance(lexer);
+    TokenType type;
     switch (c) {
-        case '+': return create_token(TOKEN_PLUS, "+", current_line, current_col);
-        case '-': return create_token(TOKEN_MINUS, "-", current_line, current_col);
-        case '*': return create_token(TOKEN_MULTIPLY, "*", current_line, current_col);
-        case '/': return create_token(TOKEN_DIVIDE, "/", current_line, current_col);
-        case '=': return create_token(TOKEN_EQUALS, "=", current_line, current_col);
-        case '<': return create_token(TOKEN_LESS, "<", current_line, current_col);
-        case '>': return create_token(TOKEN_GREATER, ">", current_line, current_col);
-        case '(': return create_token(TOKEN_LPAREN, "(", current_line, current_col);
-        case ')': return create_token(TOKEN_RPAREN, ")", current_line, current_col);
-        case '{': return create_token(TOKEN_LBRACE, "{", current_line, current_col);
-        case '}': return create_token(TOKEN_RBRACE, "}", current_line, current_col);
-        case '[': return create_token(TOKEN_LBRACKET, "[", current_line, current_col);
-        case ']': return create_token(TOKEN_RBRACKET, "]", current_line, current_col);
-        case ';': return create_token(TOKEN_SEMICOLON, ";", current_line, current_col);
-        case ',': return create_token(TOKEN_COMMA, ",", current_line, current_col);
-        case '.': return create_token(TOKEN_DOT, ".", current_line, current_col);
-        case ':': return create_token(TOKEN_COLON, ":", current_line, current_col);
+        case '+': type = TOKEN_PLUS; break;
+        case '-': type = TOKEN_MINUS; break;
+        case '*': type = TOKEN_MULTIPLY; break;
+        case '/': type = TOKEN_DIVIDE; break;
+        case '=': type = TOKEN_EQUALS; break;
+        case '<': type = TOKEN_LESS; break;
+        case '>': type = TOKEN_GREATER; break;
+        case '(': type = TOKEN_LPAREN; break;
+        case ')': type = TOKEN_RPAREN; break;
+        case '{': type = TOKEN_LBRACE; break;
+        case '}': type = TOKEN_RBRACE; break;
+        case '[': type = TOKEN_LBRACKET; break;
+        case ']': type = TOKEN_RBRACKET; break;
+        case ';': type = TOKEN_SEMICOLON; break;
+        case ',': type = TOKEN_COMMA; break;
+        case '.': type = TOKEN_DOT; break;
+        case ':': type = TOKEN_COLON; break;
+        default:
+            // Karakter tidak dikenal menghentikan tokenisasi
+            return create_token(TOKEN_EOF, current_pos, 0, current_line, current_col);
     }
-    
-    // Skip unknown character and continue
-    return NULL;
+    return create_token(type, current_pos, 1, current_line, current_col);
+}
+
+Token* tokenize(Lexer* lexer, int* count) {
+    // Perkiraan awal: rata-rata satu token per empat byte source
+    int capacity = lexer->length / 4 + 16;
+    Token* tokens = malloc(capacity * sizeof(Token));
+    if (!tokens) return NULL;
+
+    int n = 0;
+    for (;;) {
+        if (n == capacity) {
+            capacity *= 2;
+            Token* grown = realloc(tokens, capacity * sizeof(Token));
+            if (!grown) {
+                free(tokens);
+                return NULL;
+            }
+            tokens = grown;
+        }
+
+        tokens[n] = get_next_token(lexer);
+        if (tokens[n++].type == TOKEN_EOF) break;
+    }
+
+    *count = n;
+    return tokens;
 }
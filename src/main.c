@@ -1,68 +1,145 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
 #include "lexer.h"
 #include "parser.h"
 #include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+#include "source.h"
+#include "cache.h"
+#include "server.h"
 
-int main(int argc, char** argv) {
-    if (argc != 2) {
-        printf("Penggunaan: azeng <file.az>\n");
-        return 1;
-    }
-
-    // Baca file source
-    FILE* file = fopen(argv[1], "r");
-    if (!file) {
-        printf("Error: Tidak bisa membuka file %s\n", argv[1]);
-        return 1;
+// Parse source, atau ambil AST dari cache .azc kalau isinya belum berubah.
+// Program dengan error parsing tidak pernah di-cache.
+static ASTNode* load_program(const SourceFile* source, const char* path, bool use_cache) {
+    uint64_t hash = 0;
+    char* cache_path = NULL;
+    if (use_cache) {
+        hash = hash_source(source->data, source->length);
+        cache_path = cache_path_for(path, hash);
     }
 
-    // Baca seluruh isi file
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    char* source = (char*)malloc(file_size + 1);
-    if (!source) {
-        printf("Error: Gagal mengalokasi memori\n");
-        fclose(file);
-        return 1;
+    if (cache_path) {
+        ASTNode* cached = cache_load(cache_path, hash, source->length);
+        if (cached) {
+            free(cache_path);
+            return cached;
+        }
     }
 
-    size_t bytes_read = fread(source, 1, file_size, file);
-    source[bytes_read] = '\0';
-    fclose(file);
-
-    // Inisialisasi lexer
-    Lexer* lexer = create_lexer(source);
+    // Lexer bekerja langsung di atas mapping, tanpa salinan
+    Lexer* lexer = create_lexer(source->data, (int)source->length);
     if (!lexer) {
         printf("Error: Gagal membuat lexer\n");
-        free(source);
-        return 1;
+        free(cache_path);
+        return NULL;
     }
 
     Parser* parser = create_parser(lexer);
     if (!parser) {
         printf("Error: Gagal membuat parser\n");
         free_lexer(lexer);
-        free(source);
-        return 1;
+        free(cache_path);
+        return NULL;
     }
 
     ASTNode* ast = parse(parser);
+    if (ast && cache_path && parser->error_count == 0) {
+        cache_store(cache_path, hash, source->length, ast);
+    }
+
+    // Token tidak dibutuhkan lagi setelah parsing; AST punya arena sendiri
+    free_parser(parser);
+    free_lexer(lexer);
+    free(cache_path);
+    return ast;
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    bool tree_walk = false;  // --tree-walk: jalankan lewat interpreter AST
+    bool unbuffered = false; // --unbuffered: flush setiap cetak
+    bool use_cache = true;   // --no-cache: selalu parse ulang
+    const char* serve_path = NULL;    // --serve <socket>: mode daemon
+    const char* connect_path = NULL;  // --connect <socket>: kirim ke daemon
+    int max_depth = MAX_CALL_DEPTH;   // --max-depth <n>: batas pemanggilan
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tree-walk") == 0) {
+            tree_walk = true;
+        } else if (strcmp(argv[i], "--unbuffered") == 0) {
+            unbuffered = true;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            use_cache = false;
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            serve_path = argv[++i];
+        } else if (strcmp(argv[i], "--connect") == 0 && i + 1 < argc) {
+            connect_path = argv[++i];
+        } else if (strcmp(argv[i], "--max-depth") == 0 && i + 1 < argc) {
+            max_depth = atoi(argv[++i]);
+            if (max_depth < 1) {
+                path = NULL;
+                break;
+            }
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+
+    if (serve_path && !path && !connect_path) {
+        return serve(serve_path, tree_walk, use_cache, max_depth);
+    }
+
+    if (!path || serve_path) {
+        printf("Penggunaan: azeng [--tree-walk] [--unbuffered] [--no-cache] [--max-depth <n>]\n"
+               "                  <file.az | ->\n"
+               "            azeng [--tree-walk] [--no-cache] [--max-depth <n>] --serve <socket>\n"
+               "            azeng --connect <socket> <file.az | ->\n");
+        return 1;
+    }
+
+    if (connect_path) {
+        return serve_client(connect_path, path);
+    }
+
+    // File biasa di-mmap; stdin ("-") dan pipe dibaca ke memori
+    SourceFile source;
+    if (!load_source(path, &source)) {
+        printf("Error: Tidak bisa membuka file %s\n", path);
+        return 1;
+    }
+
+    ASTNode* ast = load_program(&source, path, use_cache);
+    unload_source(&source);
+
     if (ast) {
-        Interpreter* interpreter = create_interpreter();
-        if (interpreter) {
-            interpret(interpreter, ast);
-            free_interpreter(interpreter);
+        if (tree_walk) {
+            Interpreter* interpreter = create_interpreter();
+            if (interpreter) {
+                if (unbuffered) output_set_unbuffered(interpreter->out, true);
+                interpreter->max_depth = max_depth;
+                interpret(interpreter, ast);
+                free_interpreter(interpreter);
+            }
+        } else {
+            Chunk* chunk = compile_program(ast);
+            VM* vm = create_vm();
+            if (chunk && vm) {
+                if (unbuffered) output_set_unbuffered(vm->out, true);
+                vm->max_depth = max_depth;
+                vm_run(vm, chunk);
+            }
+            free_vm(vm);
+            free_chunk(chunk);
         }
         
         free_ast(ast);
     }
 
-    free_parser(parser);
-    free_lexer(lexer);
-    free(source);
-
     return 0;
 }
@@ -0,0 +1,139 @@
+#include "optimizer.h"
+#include "value.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void decode_literal(Arena* arena, ASTNode* node) {
+    switch (node->type) {
+        case AST_NUMBER:
+            node->literal.int_val = atoi(node->value);
+            break;
+
+        case AST_FLOAT:
+            node->literal.float_val = (float)atof(node->value);
+            break;
+
+        case AST_BOOLEAN:
+            node->literal.bool_val = strcmp(node->value, "benar") == 0;
+            break;
+
+        case AST_STRING: {
+            char* decoded = process_string(node->value);
+            node->literal.str_val = arena_strdup(arena, decoded);
+            free(decoded);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static bool is_literal(ASTNode* node) {
+    return node->type == AST_NUMBER || node->type == AST_FLOAT ||
+           node->type == AST_BOOLEAN || node->type == AST_STRING;
+}
+
+// Ubah node menjadi literal hasil lipatan; teksnya hanya untuk diagnostik
+static void make_int(Arena* arena, ASTNode* node, int value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%d", value);
+    node->type = AST_NUMBER;
+    node->value = arena_strdup(arena, text);
+    node->literal.int_val = value;
+}
+
+static void make_float(Arena* arena, ASTNode* node, float value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%g", value);
+    node->type = AST_FLOAT;
+    node->value = arena_strdup(arena, text);
+    node->literal.float_val = value;
+}
+
+static void make_bool(Arena* arena, ASTNode* node, bool value) {
+    node->type = AST_BOOLEAN;
+    node->value = arena_strdup(arena, value ? "benar" : "salah");
+    node->literal.bool_val = value;
+}
+
+static void fold_binary(Arena* arena, ASTNode* node) {
+    if (node->children_count != 2) return;
+
+    ASTNode* left = node->children[0];
+    ASTNode* right = node->children[1];
+    if (!is_literal(left) || !is_literal(right)) return;
+
+    if (left->type == AST_NUMBER && right->type == AST_NUMBER) {
+        int l = left->literal.int_val;
+        int r = right->literal.int_val;
+        switch (node->op) {
+            case BINOP_ADD: make_int(arena, node, l + r); break;
+            case BINOP_SUB: make_int(arena, node, l - r); break;
+            case BINOP_MUL: make_int(arena, node, l * r); break;
+            case BINOP_DIV:
+                // Pembagian dengan nol dibiarkan menjadi error saat runtime
+                if (r == 0) return;
+                make_int(arena, node, l / r);
+                break;
+            case BINOP_LT: make_bool(arena, node, l < r); break;
+            case BINOP_GT: make_bool(arena, node, l > r); break;
+            default: return;
+        }
+    }
+    else if (left->type == AST_FLOAT && right->type == AST_FLOAT) {
+        float l = left->literal.float_val;
+        float r = right->literal.float_val;
+        switch (node->op) {
+            case BINOP_ADD: make_float(arena, node, l + r); break;
+            case BINOP_SUB: make_float(arena, node, l - r); break;
+            case BINOP_MUL: make_float(arena, node, l * r); break;
+            case BINOP_DIV: make_float(arena, node, l / r); break;
+            case BINOP_LT: make_bool(arena, node, l < r); break;
+            case BINOP_GT: make_bool(arena, node, l > r); break;
+            default: return;
+        }
+    }
+    else if (left->type == AST_STRING && right->type == AST_STRING && node->op == BINOP_ADD) {
+        size_t raw_left = strlen(left->value);
+        size_t raw_right = strlen(right->value);
+        char* raw = arena_alloc(arena, raw_left + raw_right + 1);
+        memcpy(raw, left->value, raw_left);
+        memcpy(raw + raw_left, right->value, raw_right + 1);
+
+        size_t decoded_left = strlen(left->literal.str_val);
+        size_t decoded_right = strlen(right->literal.str_val);
+        char* decoded = arena_alloc(arena, decoded_left + decoded_right + 1);
+        memcpy(decoded, left->literal.str_val, decoded_left);
+        memcpy(decoded + decoded_left, right->literal.str_val, decoded_right + 1);
+
+        node->type = AST_STRING;
+        node->value = raw;
+        node->literal.str_val = decoded;
+    }
+    else {
+        return;
+    }
+
+    node->children_count = 0;
+}
+
+static void optimize_node(Arena* arena, ASTNode* node) {
+    if (!node) return;
+
+    // Anak dulu, supaya lipatan merambat dari bawah ke atas
+    for (int i = 0; i < node->children_count; i++) {
+        optimize_node(arena, node->children[i]);
+    }
+
+    if (node->type == AST_BINARY_OP) {
+        fold_binary(arena, node);
+    } else {
+        decode_literal(arena, node);
+    }
+}
+
+void optimize_program(ASTNode* program, Arena* arena) {
+    optimize_node(arena, program);
+}
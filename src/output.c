@@ -0,0 +1,111 @@
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+Output* create_output(int fd) {
+    Output* out = malloc(sizeof(Output));
+    if (!out) return NULL;
+
+    out->fd = fd;
+    out->size = 0;
+    out->capacity = OUTPUT_BUFFER_SIZE;
+    out->data = malloc(out->capacity);
+    out->unbuffered = isatty(fd);
+    if (!out->data) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+void free_output(Output* out) {
+    if (!out) return;
+    output_flush(out);
+    free(out->data);
+    free(out);
+}
+
+static void write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+void output_flush(Output* out) {
+    if (out->size == 0) return;
+    write_all(out->fd, out->data, out->size);
+    out->size = 0;
+}
+
+void output_set_unbuffered(Output* out, bool unbuffered) {
+    out->unbuffered = unbuffered;
+    if (unbuffered) output_flush(out);
+}
+
+void output_write(Output* out, const char* data, size_t length) {
+    if (out->size + length > out->capacity) {
+        output_flush(out);
+        // Potongan yang lebih besar dari buffer langsung ditulis
+        if (length > out->capacity) {
+            write_all(out->fd, data, length);
+            return;
+        }
+    }
+    memcpy(out->data + out->size, data, length);
+    out->size += length;
+}
+
+void output_char(Output* out, char c) {
+    if (out->size == out->capacity) output_flush(out);
+    out->data[out->size++] = c;
+}
+
+void output_str(Output* out, const char* str) {
+    output_write(out, str, strlen(str));
+}
+
+void output_repeat(Output* out, char c, size_t count) {
+    while (count > 0) {
+        if (out->size == out->capacity) output_flush(out);
+        size_t chunk = out->capacity - out->size;
+        if (chunk > count) chunk = count;
+        memset(out->data + out->size, c, chunk);
+        out->size += chunk;
+        count -= chunk;
+    }
+}
+
+void output_int(Output* out, int value) {
+    char digits[12];
+    int pos = sizeof(digits);
+    // Lewat unsigned supaya INT_MIN tidak overflow
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do {
+        digits[--pos] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[--pos] = '-';
+
+    output_write(out, digits + pos, sizeof(digits) - pos);
+}
+
+void output_float(Output* out, float value) {
+    // Format %f dipertahankan supaya keluaran sama seperti sebelumnya
+    char text[64];
+    int length = snprintf(text, sizeof(text), "%f", value);
+    if (length > 0) output_write(out, text, (size_t)length);
+}
+
+void output_end(Output* out) {
+    if (out->unbuffered) output_flush(out);
+}
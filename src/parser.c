@@ -1,4 +1,7 @@
 #include "parser.h"
+#include "resolver.h"
+#include "optimizer.h"
+#include "builtin.h"
 #include <stdio.h>
 #include <string.h>  // Untuk strdup()
 #include <stdbool.h> // Untuk tipe bool
@@ -16,29 +19,28 @@ static ASTNode* parse_call(Parser* parser);
 static ASTNode* parse_array_declaration(Parser* parser);
 static bool expect_token(Parser* parser, TokenType type);
 
-// Tambahkan di bagian awal file, setelah includes
-static const char* built_in_functions[] = {
-    "cetak",
-    "http_get",
-    "http_post",
-    NULL
-};
-
-static bool is_built_in_function(const char* name) {
-    for (int i = 0; built_in_functions[i] != NULL; i++) {
-        if (strcmp(built_in_functions[i], name) == 0) {
-            return true;
-        }
+// Token sudah ada di array; maju cukup menggeser index. TOKEN_EOF
+// terakhir tidak pernah dilewati.
+static void advance_token(Parser* parser) {
+    if (parser->position < parser->token_count - 1) {
+        parser->position++;
     }
-    return false;
+    parser->current_token = &parser->tokens[parser->position];
 }
 
-static Token* advance_token(Parser* parser) {
-    if (parser->current_token) {
-        free_token(parser->current_token);
+// Lookahead k token ke depan tanpa mengonsumsi
+static Token* peek_token(Parser* parser, int offset) {
+    int index = parser->position + offset;
+    if (index >= parser->token_count) {
+        index = parser->token_count - 1;
     }
-    parser->current_token = get_next_token(parser->lexer);
-    return parser->current_token;
+    return &parser->tokens[index];
+}
+
+// Buat node dengan value diambil langsung dari teks token di source
+static ASTNode* create_token_node(Parser* parser, ASTNodeType type, Token* token) {
+    return create_ast_node_n(parser->arena, type,
+                             token_text(parser->lexer, token), token->length);
 }
 
 static void parser_error(const char* message) {
@@ -46,50 +48,81 @@ static void parser_error(const char* message) {
     exit(1);
 }
 
-static ASTNode* parse_expression(Parser* parser) {
+// Prioritas operator biner; 0 berarti token bukan operator
+static int binary_precedence(TokenType type) {
+    switch (type) {
+        case TOKEN_LESS:
+        case TOKEN_GREATER:
+            return 1;
+        case TOKEN_PLUS:
+        case TOKEN_MINUS:
+            return 2;
+        case TOKEN_MULTIPLY:
+        case TOKEN_DIVIDE:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+static BinaryOperator binary_operator(TokenType type) {
+    switch (type) {
+        case TOKEN_PLUS: return BINOP_ADD;
+        case TOKEN_MINUS: return BINOP_SUB;
+        case TOKEN_MULTIPLY: return BINOP_MUL;
+        case TOKEN_DIVIDE: return BINOP_DIV;
+        case TOKEN_LESS: return BINOP_LT;
+        default: return BINOP_GT;
+    }
+}
+
+// Teks operator, hanya untuk diagnostik
+static const char* binary_operator_text(TokenType type) {
+    switch (type) {
+        case TOKEN_PLUS: return "+";
+        case TOKEN_MINUS: return "-";
+        case TOKEN_MULTIPLY: return "*";
+        case TOKEN_DIVIDE: return "/";
+        case TOKEN_LESS: return "<";
+        case TOKEN_GREATER: return ">";
+        default: return "?";
+    }
+}
+
+// Precedence climbing: operator dengan prioritas >= min_precedence diikat
+// di level ini, yang lebih tinggi diurai secara rekursif di sisi kanan.
+static ASTNode* parse_binary(Parser* parser, int min_precedence) {
     ASTNode* left = parse_primary(parser);
     if (!left) return NULL;
 
-    // Handle operators
-    while (parser->current_token) {
+    for (;;) {
         TokenType type = parser->current_token->type;
-        
-        // Cek apakah token saat ini adalah operator
-        if (type == TOKEN_PLUS || type == TOKEN_MINUS || 
-            type == TOKEN_MULTIPLY || type == TOKEN_DIVIDE ||
-            type == TOKEN_LESS || type == TOKEN_GREATER) {
-            
-            char* op;
-            switch(type) {
-                case TOKEN_PLUS: op = "+"; break;
-                case TOKEN_MINUS: op = "-"; break;
-                case TOKEN_MULTIPLY: op = "*"; break;
-                case TOKEN_DIVIDE: op = "/"; break;
-                case TOKEN_LESS: op = "<"; break;
-                case TOKEN_GREATER: op = ">"; break;
-                default: op = "?"; break;
-            }
-            
-            advance_token(parser);
-            
-            ASTNode* right = parse_primary(parser);
-            if (!right) {
-                free_ast(left);
-                return NULL;
-            }
-            
-            ASTNode* binary = create_ast_node(AST_BINARY_OP, op);
-            add_child(binary, left);
-            add_child(binary, right);
-            left = binary;
-        } else {
+        int precedence = binary_precedence(type);
+        if (precedence == 0 || precedence < min_precedence) {
             break;
         }
+        advance_token(parser);
+
+        // Semua operator asosiatif kiri
+        ASTNode* right = parse_binary(parser, precedence + 1);
+        if (!right) {
+            return NULL;
+        }
+
+        ASTNode* binary = create_ast_node(parser->arena, AST_BINARY_OP, binary_operator_text(type));
+        binary->op = binary_operator(type);
+        add_child(parser->arena, binary, left);
+        add_child(parser->arena, binary, right);
+        left = binary;
     }
-    
+
     return left;
 }
 
+static ASTNode* parse_expression(Parser* parser) {
+    return parse_binary(parser, 1);
+}
+
 static ASTNode* parse_statement(Parser* parser) {
     switch (parser->current_token->type) {
         case TOKEN_ISI: {
@@ -98,11 +131,10 @@ static ASTNode* parse_statement(Parser* parser) {
                 parser_error("Expected identifier after 'isi'");
                 return NULL;
             }
-            char* var_name = strdup(parser->current_token->value);
+            Token* var_name = parser->current_token;
             advance_token(parser);
             
             if (parser->current_token->type != TOKEN_EQUALS) {
-                free(var_name);
                 parser_error("Expected '=' after variable name");
                 return NULL;
             }
@@ -116,13 +148,11 @@ static ASTNode* parse_statement(Parser* parser) {
             }
             
             if (!expr) {
-                free(var_name);
                 return NULL;
             }
             
-            ASTNode* decl = create_ast_node(AST_VARIABLE_DECL, var_name);
-            add_child(decl, expr);
-            free(var_name);
+            ASTNode* decl = create_token_node(parser, AST_VARIABLE_DECL, var_name);
+            add_child(parser->arena, decl, expr);
             
             if (parser->current_token->type != TOKEN_SEMICOLON) {
                 parser_error("Expected ';' after variable declaration");
@@ -137,8 +167,8 @@ static ASTNode* parse_statement(Parser* parser) {
             ASTNode* expr = parse_expression(parser);
             if (!expr) return NULL;
             
-            ASTNode* ret = create_ast_node(AST_RETURN, NULL);
-            add_child(ret, expr);
+            ASTNode* ret = create_ast_node(parser->arena, AST_RETURN, NULL);
+            add_child(parser->arena, ret, expr);
             
             if (parser->current_token->type != TOKEN_SEMICOLON) {
                 parser_error("Expected ';' after return expression");
@@ -165,8 +195,8 @@ static ASTNode* parse_statement(Parser* parser) {
             }
             advance_token(parser);
             
-            ASTNode* print = create_ast_node(AST_CALL, "cetak");
-            add_child(print, expr);
+            ASTNode* print = create_ast_node(parser->arena, AST_CALL, "cetak");
+            add_child(parser->arena, print, expr);
             
             if (parser->current_token->type != TOKEN_SEMICOLON) {
                 parser_error("Expected ';' after print statement");
@@ -184,28 +214,9 @@ static ASTNode* parse_statement(Parser* parser) {
             }
             advance_token(parser);
 
-            // Parse condition
-            ASTNode* condition = create_ast_node(AST_BINARY_OP, ">");
-            
-            if (parser->current_token->type != TOKEN_IDENTIFIER) {
-                parser_error("Expected identifier in condition");
-            }
-            ASTNode* left = create_ast_node(AST_IDENTIFIER, parser->current_token->value);
-            advance_token(parser);
-
-            if (parser->current_token->type != TOKEN_GREATER) {
-                parser_error("Expected '>' in condition");
-            }
-            advance_token(parser);
-
-            if (parser->current_token->type != TOKEN_NUMBER) {
-                parser_error("Expected number in condition");
-            }
-            ASTNode* right = create_ast_node(AST_NUMBER, parser->current_token->value);
-            advance_token(parser);
-
-            add_child(condition, left);
-            add_child(condition, right);
+            // Kondisi boleh ekspresi apa saja, sama seperti ulang
+            ASTNode* condition = parse_expression(parser);
+            if (!condition) return NULL;
 
             if (parser->current_token->type != TOKEN_RPAREN) {
                 parser_error("Expected ')'");
@@ -218,15 +229,15 @@ static ASTNode* parse_statement(Parser* parser) {
             advance_token(parser);
 
             // Parse if body
-            ASTNode* if_node = create_ast_node(AST_IF, NULL);
-            add_child(if_node, condition);
+            ASTNode* if_node = create_ast_node(parser->arena, AST_IF, NULL);
+            add_child(parser->arena, if_node, condition);
 
-            ASTNode* body = create_ast_node(AST_BLOCK, NULL);
+            ASTNode* body = create_ast_node(parser->arena, AST_BLOCK, NULL);
             while (parser->current_token->type != TOKEN_RBRACE) {
                 ASTNode* stmt = parse_statement(parser);
-                if (stmt) add_child(body, stmt);
+                if (stmt) add_child(parser->arena, body, stmt);
             }
-            add_child(if_node, body);
+            add_child(parser->arena, if_node, body);
             
             advance_token(parser); // consume '}'
             return if_node;
@@ -258,23 +269,35 @@ static ASTNode* parse_statement(Parser* parser) {
             advance_token(parser);
             
             // Parse body
-            ASTNode* body = create_ast_node(AST_BLOCK, NULL);
+            ASTNode* body = create_ast_node(parser->arena, AST_BLOCK, NULL);
             while (parser->current_token->type != TOKEN_RBRACE) {
                 ASTNode* stmt = parse_statement(parser);
-                if (stmt) add_child(body, stmt);
+                if (stmt) add_child(parser->arena, body, stmt);
             }
             advance_token(parser);
             
             // Buat node while
-            ASTNode* while_node = create_ast_node(AST_WHILE, NULL);
-            add_child(while_node, condition);
-            add_child(while_node, body);
+            ASTNode* while_node = create_ast_node(parser->arena, AST_WHILE, NULL);
+            add_child(parser->arena, while_node, condition);
+            add_child(parser->arena, while_node, body);
             
             return while_node;
         }
         
         case TOKEN_IDENTIFIER: {
-            char* var_name = strdup(parser->current_token->value);
+            // Pemanggilan sebagai statement: array_isi(a, 0); atau fungsi user
+            if (peek_token(parser, 1)->type == TOKEN_LPAREN) {
+                ASTNode* call = parse_call(parser);
+                if (!call) return NULL;
+                if (parser->current_token->type != TOKEN_SEMICOLON) {
+                    parser_error("Expected ';' after function call");
+                    return NULL;
+                }
+                advance_token(parser);
+                return call;
+            }
+
+            Token* var_name = parser->current_token;
             advance_token(parser);
 
             // Handle array access and assignment: arr[index] = value
@@ -282,12 +305,10 @@ static ASTNode* parse_statement(Parser* parser) {
                 advance_token(parser);
                 ASTNode* index = parse_expression(parser);
                 if (!index) {
-                    free(var_name);
                     return NULL;
                 }
                 
                 if (parser->current_token->type != TOKEN_RBRACKET) {
-                    free(var_name);
                     parser_error("Expected ']' after array index");
                     return NULL;
                 }
@@ -295,34 +316,29 @@ static ASTNode* parse_statement(Parser* parser) {
                 
                 if (parser->current_token->type == TOKEN_EQUALS) {
                     advance_token(parser);
-                    ASTNode* assign = create_ast_node(AST_ARRAY_ASSIGN, var_name);
+                    ASTNode* assign = create_token_node(parser, AST_ARRAY_ASSIGN, var_name);
                     ASTNode* value = parse_expression(parser);
                     if (!value) {
-                        free(var_name);
-                        free_ast(index);
                         return NULL;
                     }
                     
-                    add_child(assign, index);   // First child is index
-                    add_child(assign, value);   // Second child is value
+                    add_child(parser->arena, assign, index);   // First child is index
+                    add_child(parser->arena, assign, value);   // Second child is value
                     
                     if (parser->current_token->type != TOKEN_SEMICOLON) {
-                        free(var_name);
                         parser_error("Expected ';' after array assignment");
                         return NULL;
                     }
                     advance_token(parser);
-                    free(var_name);
                     return assign;
                 }
             }
 
             if (parser->current_token->type == TOKEN_EQUALS) {
                 advance_token(parser);
-                ASTNode* assign = create_ast_node(AST_ASSIGNMENT, var_name);
+                ASTNode* assign = create_token_node(parser, AST_ASSIGNMENT, var_name);
                 ASTNode* value = parse_expression(parser);
-                add_child(assign, value);
-                free(var_name);
+                add_child(parser->arena, assign, value);
 
                 if (parser->current_token->type != TOKEN_SEMICOLON) {
                     parser_error("Expected ';'");
@@ -330,7 +346,6 @@ static ASTNode* parse_statement(Parser* parser) {
                 advance_token(parser);
                 return assign;
             }
-            free(var_name);
             break;
         }
         
@@ -385,7 +400,7 @@ static ASTNode* parse_function(Parser* parser) {
         parser_error("Expected function name");
         return NULL;
     }
-    ASTNode* func = create_ast_node(AST_FUNCTION, parser->current_token->value);
+    ASTNode* func = create_token_node(parser, AST_FUNCTION, parser->current_token);
     func->data_type = return_type;  // Set return type
     advance_token(parser);
 
@@ -404,12 +419,11 @@ static ASTNode* parse_function(Parser* parser) {
         }
         
         // Get parameter name
-        char* param_name = strdup(parser->current_token->value);
+        Token* param_name = parser->current_token;
         advance_token(parser);
         
         // Expect colon
         if (parser->current_token->type != TOKEN_COLON) {
-            free(param_name);
             parser_error("Expected ':' after parameter name");
             return NULL;
         }
@@ -431,17 +445,15 @@ static ASTNode* parse_function(Parser* parser) {
                 param_type = TYPE_STRING;
                 break;
             default:
-                free(param_name);
                 parser_error("Expected parameter type");
                 return NULL;
         }
         advance_token(parser);
         
         // Create parameter node
-        ASTNode* param = create_ast_node(AST_PARAMETER, param_name);
+        ASTNode* param = create_token_node(parser, AST_PARAMETER, param_name);
         param->data_type = param_type;
-        add_child(func, param);
-        free(param_name);
+        add_child(parser->arena, func, param);
         
         // Check for comma
         if (parser->current_token->type == TOKEN_COMMA) {
@@ -467,14 +479,14 @@ static ASTNode* parse_function(Parser* parser) {
     advance_token(parser);
 
     // Parse function body statements
-    ASTNode* body = create_ast_node(AST_BLOCK, NULL);
+    ASTNode* body = create_ast_node(parser->arena, AST_BLOCK, NULL);
     while (parser->current_token->type != TOKEN_RBRACE) {
         ASTNode* stmt = parse_statement(parser);
         if (stmt) {
-            add_child(body, stmt);
+            add_child(parser->arena, body, stmt);
         }
     }
-    add_child(func, body);
+    add_child(parser->arena, func, body);
     advance_token(parser);
 
     return func;
@@ -486,35 +498,48 @@ static ASTNode* parse_primary(Parser* parser) {
 
     switch (token->type) {
         case TOKEN_NUMBER: {
-            node = create_ast_node(AST_NUMBER, token->value);
+            node = create_token_node(parser, AST_NUMBER, token);
+            advance_token(parser);
+            return node;
+        }
+        
+        case TOKEN_FLOAT: {
+            node = create_token_node(parser, AST_FLOAT, token);
             advance_token(parser);
             return node;
         }
         
         case TOKEN_STRING: {
-            node = create_ast_node(AST_STRING, token->value);
+            node = create_token_node(parser, AST_STRING, token);
+            advance_token(parser);
+            return node;
+        }
+        
+        case TOKEN_BENAR:
+        case TOKEN_SALAH: {
+            node = create_token_node(parser, AST_BOOLEAN, token);
             advance_token(parser);
             return node;
         }
         
         case TOKEN_IDENTIFIER: {
-            // Cek apakah ini function call
-            if (is_built_in_function(token->value)) {
+            // Function call; builtin atau fungsi user dicek di link_calls
+            if (peek_token(parser, 1)->type == TOKEN_LPAREN) {
                 return parse_call(parser);
             }
             
-            node = create_ast_node(AST_IDENTIFIER, token->value);
+            node = create_token_node(parser, AST_IDENTIFIER, token);
             advance_token(parser);
             
             // Cek array access
             if (parser->current_token->type == TOKEN_LBRACKET) {
-                ASTNode* array_access = create_ast_node(AST_ARRAY_ACCESS, node->value);
+                ASTNode* array_access = create_ast_node(parser->arena, AST_ARRAY_ACCESS, node->value);
                 advance_token(parser);
                 
                 ASTNode* index = parse_expression(parser);
                 if (!index) return NULL;
                 
-                add_child(array_access, index);
+                add_child(parser->arena, array_access, index);
                 
                 if (parser->current_token->type != TOKEN_RBRACKET) {
                     parser_error("Expected ']'");
@@ -522,7 +547,6 @@ static ASTNode* parse_primary(Parser* parser) {
                 }
                 advance_token(parser);
                 
-                free_ast(node);
                 return array_access;
             }
             
@@ -544,49 +568,134 @@ Parser* create_parser(Lexer* lexer) {
     if (!parser) return NULL;
 
     parser->lexer = lexer;
-    parser->current_token = NULL;
-    advance_token(parser);
+    parser->tokens = tokenize(lexer, &parser->token_count);
+    parser->position = 0;
+    parser->error_count = 0;
+    parser->arena = create_arena();
+    if (!parser->tokens || !parser->arena) {
+        free(parser->tokens);
+        free_arena(parser->arena);
+        free(parser);
+        return NULL;
+    }
+    parser->current_token = &parser->tokens[0];
     return parser;
 }
 
 void free_parser(Parser* parser) {
     if (parser) {
-        if (parser->current_token) {
-            free_token(parser->current_token);
-        }
+        // Arena hanya masih dimiliki parser kalau parse() belum dipanggil
+        free_arena(parser->arena);
+        free(parser->tokens);
         free(parser);
     }
 }
 
+// Argumen callback builtin (nama fungsi user) diganti index fungsinya,
+// jadi kedua engine cukup menerima angka
+static void link_callbacks(ASTNode* program, ASTNode* call, unsigned callbacks) {
+    for (int i = 0; i < call->children_count; i++) {
+        if (!(callbacks & (1u << i))) continue;
+
+        ASTNode* arg = call->children[i];
+        ASTNode* function = arg->type == AST_IDENTIFIER ? find_function(program, arg->value) : NULL;
+        if (!function) {
+            char message[160];
+            snprintf(message, sizeof(message), "Unknown function '%s'", arg->value ? arg->value : "");
+            parser_error(message);
+        }
+        arg->type = AST_NUMBER;
+        arg->literal.int_val = function->slot;
+    }
+}
+
+// Hubungkan setiap AST_CALL ke fungsi user (slot = index fungsi) atau
+// builtin (slot -1, literal.builtin). Fungsi boleh dipanggil sebelum
+// dideklarasikan, jadi ini baru bisa dilakukan setelah seluruh program diurai.
+static void link_calls(ASTNode* program, ASTNode* node) {
+    if (node->type == AST_CALL) {
+        char message[160];
+        ASTNode* function = find_function(program, node->value);
+        const Builtin* builtin = function ? NULL : find_builtin(node->value);
+        if (function) {
+            int expected = function_param_count(function);
+            if (node->children_count != expected) {
+                snprintf(message, sizeof(message), "Function '%s' expects %d arguments, got %d",
+                         node->value, expected, node->children_count);
+                parser_error(message);
+            }
+            node->slot = function->slot;
+        } else if (!builtin) {
+            snprintf(message, sizeof(message), "Unknown function '%s'", node->value);
+            parser_error(message);
+        } else {
+            if (node->children_count < builtin->min_args ||
+                node->children_count > builtin->max_args) {
+                if (builtin->min_args == builtin->max_args) {
+                    snprintf(message, sizeof(message), "Function '%s' expects %d arguments, got %d",
+                             node->value, builtin->min_args, node->children_count);
+                } else {
+                    snprintf(message, sizeof(message),
+                             "Function '%s' expects %d to %d arguments, got %d",
+                             node->value, builtin->min_args, builtin->max_args,
+                             node->children_count);
+                }
+                parser_error(message);
+            }
+            node->literal.builtin = builtin;
+            link_callbacks(program, node, builtin->callbacks);
+        }
+    }
+
+    for (int i = 0; i < node->children_count; i++) {
+        link_calls(program, node->children[i]);
+    }
+}
+
 ASTNode* parse(Parser* parser) {
-    ASTNode* program = create_ast_node(AST_PROGRAM, NULL);
+    ASTNode* program = create_ast_node(parser->arena, AST_PROGRAM, NULL);
     
-    while (parser->current_token && parser->current_token->type != TOKEN_EOF) {
+    while (parser->current_token->type != TOKEN_EOF) {
         ASTNode* func = parse_function(parser);
         if (func) {
-            add_child(program, func);
+            if (find_function(program, func->value)) {
+                char message[160];
+                snprintf(message, sizeof(message), "Function '%s' already defined", func->value);
+                parser_error(message);
+            }
+            func->slot = program->children_count;
+            add_child(parser->arena, program, func);
         }
     }
-    
+    // Decode literal dan lipat konstanta, hubungkan pemanggilan, lalu
+    // resolve nama variabel ke slot frame; semuanya cukup sekali sebelum
+    // program dijalankan. Nama callback sudah menjadi angka sebelum resolve.
+    optimize_program(program, parser->arena);
+    link_calls(program, program);
+    ASTNode* undefined;
+    resolve_program(program, &undefined);
+    if (undefined) {
+        char message[160];
+        snprintf(message, sizeof(message), "Variable '%s' used before it is defined",
+                 undefined->value);
+        parser_error(message);
+    }
+
+    // Seluruh memori AST sekarang milik root
+    program->arena = parser->arena;
+    parser->arena = NULL;
     return program;
 }
 
 static ASTNode* parse_call(Parser* parser) {
-    const char* function_name = parser->current_token->value;
-    
-    if (!is_built_in_function(function_name)) {
-        fprintf(stderr, "Error: Unknown function '%s'\n", function_name);
-        return NULL;
-    }
-    
-    ASTNode* node = create_ast_node(AST_CALL, function_name);
+    Token* function_name = parser->current_token;
+    ASTNode* node = create_token_node(parser, AST_CALL, function_name);
     
     // Consume function name
     advance_token(parser);
     
     // Expect opening parenthesis
     if (!expect_token(parser, TOKEN_LPAREN)) {
-        free_ast(node);
         return NULL;
     }
     
@@ -594,16 +703,15 @@ static ASTNode* parse_call(Parser* parser) {
     while (parser->current_token->type != TOKEN_RPAREN) {
         ASTNode* arg = parse_expression(parser);
         if (!arg) {
-            free_ast(node);
             return NULL;
         }
-        add_child(node, arg);
+        add_child(parser->arena, node, arg);
         
         if (parser->current_token->type == TOKEN_COMMA) {
             advance_token(parser);
         } else if (parser->current_token->type != TOKEN_RPAREN) {
             fprintf(stderr, "Error: Expected ',' or ')'\n");
-            free_ast(node);
+            parser->error_count++;
             return NULL;
         }
     }
@@ -626,7 +734,7 @@ static bool expect_token(Parser* parser, TokenType type) {
 }
 
 static ASTNode* parse_array_declaration(Parser* parser) {
-    ASTNode* array_node = create_ast_node(AST_ARRAY_DECL, NULL);
+    ASTNode* array_node = create_ast_node(parser->arena, AST_ARRAY_DECL, NULL);
     
     // Skip token 'array'
     advance_token(parser);
@@ -655,15 +763,13 @@ static ASTNode* parse_array_declaration(Parser* parser) {
     // Parse ukuran array
     ASTNode* size = parse_expression(parser);
     if (!size) {
-        free_ast(array_node);
         return NULL;
     }
-    add_child(array_node, size);
+    add_child(parser->arena, array_node, size);
     
     // Expect ']'
     if (!expect_token(parser, TOKEN_RBRACKET)) {
         parser_error("Expected ']'");
-        free_ast(array_node);
         return NULL;
     }
     
@@ -0,0 +1,164 @@
+#include "resolver.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Tabel hash open addressing nama -> slot, hanya hidup selama resolve
+typedef struct {
+    const char** names;
+    int* slots;
+    bool* defined;          // Per slot: pasti sudah diisi di titik ini
+    int capacity;
+    int count;
+    ASTNode* undefined;     // Pembacaan pertama sebelum variabelnya diisi
+} SymbolTable;
+
+static uint32_t hash_name(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void table_grow(SymbolTable* table);
+
+static int table_lookup_or_add(SymbolTable* table, const char* name) {
+    if ((table->count + 1) * 2 > table->capacity) {
+        table_grow(table);
+    }
+
+    uint32_t mask = (uint32_t)table->capacity - 1;
+    uint32_t index = hash_name(name) & mask;
+    while (table->names[index]) {
+        if (strcmp(table->names[index], name) == 0) {
+            return table->slots[index];
+        }
+        index = (index + 1) & mask;
+    }
+
+    table->names[index] = name;
+    table->slots[index] = table->count;
+    return table->count++;
+}
+
+static void table_grow(SymbolTable* table) {
+    int old_capacity = table->capacity;
+    const char** old_names = table->names;
+    int* old_slots = table->slots;
+
+    table->capacity = old_capacity ? old_capacity * 2 : 64;
+    table->names = calloc(table->capacity, sizeof(char*));
+    table->slots = calloc(table->capacity, sizeof(int));
+    table->defined = realloc(table->defined, table->capacity * sizeof(bool));
+    memset(table->defined + old_capacity, 0, (table->capacity - old_capacity) * sizeof(bool));
+
+    uint32_t mask = (uint32_t)table->capacity - 1;
+    for (int i = 0; i < old_capacity; i++) {
+        if (!old_names[i]) continue;
+        uint32_t index = hash_name(old_names[i]) & mask;
+        while (table->names[index]) {
+            index = (index + 1) & mask;
+        }
+        table->names[index] = old_names[i];
+        table->slots[index] = old_slots[i];
+    }
+
+    free(old_names);
+    free(old_slots);
+}
+
+static void resolve_node(SymbolTable* table, ASTNode* node);
+
+// Isi kalo/ulang mungkin tidak dijalankan, jadi variabel yang baru diisi di
+// dalamnya belum pasti terdefinisi sesudahnya
+static void resolve_branch(SymbolTable* table, ASTNode* node) {
+    resolve_node(table, node->children[0]);
+
+    int count = table->count;
+    bool* saved = malloc(count * sizeof(bool) + 1);
+    memcpy(saved, table->defined, count * sizeof(bool));
+    for (int i = 1; i < node->children_count; i++) {
+        resolve_node(table, node->children[i]);
+    }
+    memcpy(table->defined, saved, count * sizeof(bool));
+    memset(table->defined + count, 0, (table->count - count) * sizeof(bool));
+    free(saved);
+}
+
+static void resolve_node(SymbolTable* table, ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_IF:
+        case AST_WHILE:
+            resolve_branch(table, node);
+            return;
+        case AST_IDENTIFIER:
+        case AST_VARIABLE_DECL:
+        case AST_ASSIGNMENT:
+        case AST_ARRAY_ACCESS:
+        case AST_ARRAY_ASSIGN:
+        case AST_PARAMETER:
+            if (node->value) {
+                node->slot = table_lookup_or_add(table, node->value);
+            }
+            break;
+        default:
+            break;
+    }
+
+    for (int i = 0; i < node->children_count; i++) {
+        resolve_node(table, node->children[i]);
+    }
+
+    // Ekspresi tidak bisa mengisi variabel, jadi cukup dicek setelah
+    // anak-anaknya; nilai baru berlaku setelah ruas kanan dievaluasi
+    if (!node->value) return;
+    switch (node->type) {
+        case AST_IDENTIFIER:
+        case AST_ARRAY_ACCESS:
+        case AST_ARRAY_ASSIGN:
+            if (!table->defined[node->slot] && !table->undefined) {
+                table->undefined = node;
+            }
+            break;
+        case AST_VARIABLE_DECL:
+        case AST_ASSIGNMENT:
+        case AST_PARAMETER:
+            table->defined[node->slot] = true;
+            break;
+        default:
+            break;
+    }
+}
+
+int resolve_program(ASTNode* program, ASTNode** undefined) {
+    *undefined = NULL;
+    if (!program) return 0;
+
+    // Setiap fungsi punya frame sendiri. Parameter adalah anak pertama
+    // AST_FUNCTION, jadi mendapat slot 0..param_count-1.
+    SymbolTable table = {0};
+    int largest = 0;
+    for (int i = 0; i < program->children_count; i++) {
+        ASTNode* function = program->children[i];
+        if (table.capacity > 0) {
+            memset(table.names, 0, table.capacity * sizeof(char*));
+            memset(table.defined, 0, table.capacity * sizeof(bool));
+        }
+        table.count = 0;
+
+        resolve_node(&table, function);
+        function->frame_size = table.count;
+        if (table.count > largest) largest = table.count;
+    }
+    free(table.names);
+    free(table.slots);
+    free(table.defined);
+    *undefined = table.undefined;
+
+    program->frame_size = largest;
+    return largest;
+}
@@ -0,0 +1,373 @@
+#include "server.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "lexer.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "compiler.h"
+#include "vm.h"
+#include "source.h"
+#include "cache.h"
+
+#define SERVE_CACHE_SIZE 64
+#define SERVE_IO_TIMEOUT 10      // Detik; klien yang macet tidak menahan daemon
+#define SERVE_RUN_TIMEOUT 30     // Detik; script yang tidak berhenti tidak menahan request lain
+#define PARSE_WITH_ERRORS 2      // Exit code anak: AST ada tapi jangan di-cache
+
+typedef struct {
+    uint64_t hash;
+    size_t length;
+    ASTNode* program;
+    Chunk* chunk;           // Dikompilasi saat pertama dijalankan VM
+} CachedProgram;
+
+typedef struct {
+    CachedProgram programs[SERVE_CACHE_SIZE];
+    int next;               // Slot berikutnya yang diganti (round-robin)
+    HttpClient* http;       // Pool koneksi dipakai semua request
+    bool tree_walk;
+    bool use_cache;
+    int max_depth;
+} Server;
+
+static volatile sig_atomic_t stopping = 0;
+static volatile sig_atomic_t timed_out = 0;   // Dicek engine lewat interrupt
+
+static void handle_stop(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+static void handle_timeout(int sig) {
+    (void)sig;
+    timed_out = 1;
+}
+
+static void set_run_timer(int seconds) {
+    struct itimerval timer = { .it_value = { .tv_sec = seconds } };
+    setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+static bool write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t count = write(fd, data, length);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+
+// Baca dari fd ke buffer yang tumbuh. Berhenti di EOF, atau setelah baris
+// pertama kalau stop_at_line dan baris itu bukan "-".
+static char* read_request(int fd, size_t* length, bool stop_at_line) {
+    size_t capacity = 4096;
+    size_t used = 0;
+    char* data = malloc(capacity + 1);
+    if (!data) return NULL;
+
+    for (;;) {
+        if (stop_at_line && used > 0) {
+            char* newline = memchr(data, '\n', used);
+            if (newline && !(newline - data == 1 && data[0] == '-')) break;
+        }
+        if (used == capacity) {
+            capacity *= 2;
+            char* grown = realloc(data, capacity + 1);
+            if (!grown) {
+                free(data);
+                return NULL;
+            }
+            data = grown;
+        }
+
+        ssize_t count = read(fd, data + used, capacity - used);
+        if (count == 0) break;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            free(data);
+            return NULL;
+        }
+        used += (size_t)count;
+    }
+
+    data[used] = '\0';
+    *length = used;
+    return data;
+}
+
+static void release_program(CachedProgram* entry) {
+    free_chunk(entry->chunk);
+    free_ast(entry->program);
+    memset(entry, 0, sizeof(*entry));
+}
+
+// parser_error dan compiler_error memanggil exit(1), jadi parsing dijalankan
+// di proses anak. Anak mengirim AST dalam format .azc lewat pipe; error
+// parsing sudah ditulis anak ke stderr, yang sedang diarahkan ke klien.
+static ASTNode* parse_isolated(Server* server, const char* data, size_t length,
+                               uint64_t hash, bool* cacheable) {
+    int fds[2];
+    if (pipe(fds) != 0) return NULL;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return NULL;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        Lexer* lexer = create_lexer(data, (int)length);
+        Parser* parser = lexer ? create_parser(lexer) : NULL;
+        ASTNode* ast = parser ? parse(parser) : NULL;
+        if (!ast) _exit(1);
+        // Kompilasi hanya untuk memastikan compiler tidak akan exit di daemon
+        if (!server->tree_walk) compile_program(ast);
+
+        size_t size;
+        char* encoded = cache_encode(ast, hash, length, &size);
+        if (!encoded || !write_all(fds[1], encoded, size)) _exit(1);
+        _exit(parser->error_count == 0 ? 0 : PARSE_WITH_ERRORS);
+    }
+
+    close(fds[1]);
+    size_t size = 0;
+    char* encoded = read_request(fds[0], &size, false);
+    close(fds[0]);
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+    ASTNode* program = NULL;
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    if (encoded && (code == 0 || code == PARSE_WITH_ERRORS)) {
+        program = cache_decode(encoded, size, hash, length);
+        *cacheable = code == 0;
+    }
+    free(encoded);
+    return program;
+}
+
+// Cari di cache memori, lalu cache .azc, baru parse. Program dengan error
+// parsing tidak masuk cache dan tidak menggusur entry lain: program itu
+// disimpan di scratch dan dibuang pemanggil setelah request selesai.
+static CachedProgram* find_program(Server* server, const char* path,
+                                   const char* data, size_t length,
+                                   CachedProgram* scratch) {
+    uint64_t hash = hash_source(data, length);
+    for (int i = 0; i < SERVE_CACHE_SIZE; i++) {
+        CachedProgram* entry = &server->programs[i];
+        if (entry->program && entry->hash == hash && entry->length == length) {
+            return entry;
+        }
+    }
+
+    char* cache_path = server->use_cache ? cache_path_for(path, hash) : NULL;
+    bool cacheable = true;
+    ASTNode* program = cache_path ? cache_load(cache_path, hash, length) : NULL;
+    if (!program) {
+        program = parse_isolated(server, data, length, hash, &cacheable);
+        if (program && cache_path && cacheable) {
+            cache_store(cache_path, hash, length, program);
+        }
+    }
+    free(cache_path);
+    if (!program) return NULL;
+
+    CachedProgram* entry = scratch;
+    if (cacheable) {
+        entry = &server->programs[server->next];
+        server->next = (server->next + 1) % SERVE_CACHE_SIZE;
+        release_program(entry);
+    }
+    entry->hash = hash;
+    entry->length = length;
+    entry->program = program;
+    return entry;
+}
+
+// Script dijalankan di proses daemon supaya pool koneksi dipakai bersama;
+// setelah SERVE_RUN_TIMEOUT engine berhenti dengan error
+static void run_program(Server* server, CachedProgram* entry, int fd) {
+    if (!server->tree_walk && !entry->chunk) entry->chunk = compile_program(entry->program);
+
+    timed_out = 0;
+    set_run_timer(SERVE_RUN_TIMEOUT);
+    if (server->tree_walk) {
+        Interpreter* interpreter = create_interpreter_shared(server->http, fd);
+        if (interpreter) {
+            interpreter->max_depth = server->max_depth;
+            interpreter->interrupt = &timed_out;
+            interpret(interpreter, entry->program);
+            free_interpreter(interpreter);
+        }
+    } else {
+        VM* vm = create_vm_shared(server->http, fd);
+        if (vm && entry->chunk) {
+            vm->max_depth = server->max_depth;
+            vm->interrupt = &timed_out;
+            vm_run(vm, entry->chunk);
+        }
+        free_vm(vm);
+    }
+    set_run_timer(0);
+}
+
+static void handle_request(Server* server, int client) {
+    struct timeval timeout = { .tv_sec = SERVE_IO_TIMEOUT };
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    size_t length;
+    char* request = read_request(client, &length, true);
+    if (!request) return;
+
+    char* newline = memchr(request, '\n', length);
+    if (!newline) {
+        free(request);
+        return;
+    }
+    *newline = '\0';
+    const char* path = request;
+
+    // Pesan error script (stderr) ikut dikirim ke klien
+    int saved_stderr = dup(STDERR_FILENO);
+    dup2(client, STDERR_FILENO);
+
+    SourceFile source = { .data = newline + 1, .length = length - (size_t)(newline + 1 - request) };
+    bool loaded = strcmp(path, "-") == 0 || load_source(path, &source);
+    if (!loaded) {
+        fprintf(stderr, "Error: Tidak bisa membuka file %s\n", path);
+    } else {
+        CachedProgram scratch = {0};
+        CachedProgram* entry = find_program(server, path, source.data, source.length, &scratch);
+        if (source.data != newline + 1) unload_source(&source);
+        if (entry) run_program(server, entry, client);
+        release_program(&scratch);
+    }
+
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stderr);
+    free(request);
+}
+
+int serve(const char* socket_path, bool tree_walk, bool use_cache, int max_depth) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: Path socket terlalu panjang\n");
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(socket_path);
+    // Socket dibuat langsung dengan mode 0600; chmod setelah bind masih
+    // menyisakan jeda saat user lain bisa connect
+    mode_t old_umask = umask(077);
+    int bound = bind(listener, (struct sockaddr*)&addr, sizeof(addr));
+    umask(old_umask);
+    if (bound != 0 || listen(listener, SOMAXCONN) != 0) {
+        perror(socket_path);
+        close(listener);
+        return 1;
+    }
+
+    // Klien yang putus di tengah jalan tidak boleh mematikan daemon.
+    // Tanpa SA_RESTART supaya accept() kembali saat SIGINT/SIGTERM.
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction action = { .sa_handler = handle_stop };
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    // SA_RESTART: timer tidak boleh memutus tulisan ke klien
+    struct sigaction timeout_action = { .sa_handler = handle_timeout, .sa_flags = SA_RESTART };
+    sigemptyset(&timeout_action.sa_mask);
+    sigaction(SIGALRM, &timeout_action, NULL);
+
+    Server server = {0};
+    server.http = create_http_client();
+    server.tree_walk = tree_walk;
+    server.use_cache = use_cache;
+    server.max_depth = max_depth;
+    fprintf(stderr, "azeng: melayani di %s\n", socket_path);
+
+    while (!stopping) {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+        handle_request(&server, client);
+        close(client);
+    }
+
+    close(listener);
+    unlink(socket_path);
+    for (int i = 0; i < SERVE_CACHE_SIZE; i++) {
+        release_program(&server.programs[i]);
+    }
+    free_http_client(server.http);
+    return 0;
+}
+
+int serve_client(const char* socket_path, const char* script_path) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: Path socket terlalu panjang\n");
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        perror(socket_path);
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    // Daemon punya direktori kerja sendiri, jadi path dikirim absolut
+    bool ok;
+    if (strcmp(script_path, "-") == 0) {
+        size_t length;
+        char* source = read_request(STDIN_FILENO, &length, false);
+        ok = source && write_all(fd, "-\n", 2) && write_all(fd, source, length);
+        free(source);
+    } else {
+        char resolved[PATH_MAX];
+        ok = realpath(script_path, resolved) != NULL;
+        if (!ok) {
+            printf("Error: Tidak bisa membuka file %s\n", script_path);
+        } else {
+            size_t length = strlen(resolved);
+            resolved[length] = '\n';
+            ok = write_all(fd, resolved, length + 1);
+        }
+    }
+    shutdown(fd, SHUT_WR);
+
+    char buffer[64 * 1024];
+    ssize_t count;
+    while (ok && ((count = read(fd, buffer, sizeof(buffer))) > 0 ||
+                  (count < 0 && errno == EINTR))) {
+        if (count > 0) ok = write_all(STDOUT_FILENO, buffer, (size_t)count);
+    }
+    close(fd);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include "source.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Ukuran tidak diketahui (stdin/pipe): baca sampai EOF dengan buffer
+// yang tumbuh dua kali lipat
+static bool read_stream(int fd, SourceFile* source) {
+    size_t capacity = 64 * 1024;
+    size_t length = 0;
+    char* data = malloc(capacity);
+    if (!data) return false;
+
+    for (;;) {
+        if (length == capacity) {
+            capacity *= 2;
+            char* grown = realloc(data, capacity);
+            if (!grown) {
+                free(data);
+                return false;
+            }
+            data = grown;
+        }
+
+        ssize_t count = read(fd, data + length, capacity - length);
+        if (count == 0) break;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            free(data);
+            return false;
+        }
+        length += (size_t)count;
+    }
+
+    if (length == 0) {
+        // Sama seperti file kosong: tidak ada yang perlu dibebaskan
+        free(data);
+        data = "";
+    }
+    source->data = data;
+    source->length = length;
+    source->mapped = false;
+    return true;
+}
+
+bool load_source(const char* path, SourceFile* source) {
+    if (strcmp(path, "-") == 0) {
+        return read_stream(STDIN_FILENO, source);
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        return false;
+    }
+
+    bool ok;
+    if (!S_ISREG(info.st_mode)) {
+        ok = read_stream(fd, source);
+    } else if (info.st_size == 0) {
+        // mmap dengan panjang 0 tidak valid
+        source->data = "";
+        source->length = 0;
+        source->mapped = false;
+        ok = true;
+    } else {
+        void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ok = data != MAP_FAILED;
+        if (ok) {
+            madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+            source->data = data;
+            source->length = (size_t)info.st_size;
+            source->mapped = true;
+        }
+    }
+
+    // Mapping tetap valid setelah fd ditutup
+    close(fd);
+    return ok;
+}
+
+void unload_source(SourceFile* source) {
+    if (source->mapped) {
+        munmap((void*)source->data, source->length);
+    } else if (source->length > 0) {
+        free((void*)source->data);
+    }
+    source->data = NULL;
+    source->length = 0;
+    source->mapped = false;
+}
@@ -0,0 +1,68 @@
+#include "str.h"
+#include <stdlib.h>
+#include <string.h>
+
+size_t value_heap_allocations = 0;
+
+String* string_alloc(size_t length) {
+    String* str = malloc(sizeof(String) + length + 1);
+    if (!str) return NULL;
+    value_heap_allocations++;
+    str->refcount = 1;
+    str->length = length;
+    str->capacity = length;
+    str->data = str->inline_data;
+    str->data[length] = '\0';
+    return str;
+}
+
+String* string_new(const char* data, size_t length) {
+    String* str = string_alloc(length);
+    if (str) memcpy(str->data, data, length);
+    return str;
+}
+
+String* string_adopt(char* buffer, size_t length) {
+    String* str = malloc(sizeof(String));
+    if (!str) {
+        free(buffer);
+        return NULL;
+    }
+    value_heap_allocations++;
+    str->refcount = 1;
+    str->length = length;
+    str->capacity = length;
+    str->data = buffer;
+    return str;
+}
+
+String* string_append(String* str, const char* data, size_t length) {
+    size_t needed = str->length + length;
+    if (needed > str->capacity) {
+        size_t capacity = str->capacity * 2;
+        if (capacity < needed) capacity = needed;
+        if (str->data == str->inline_data) {
+            String* grown = realloc(str, sizeof(String) + capacity + 1);
+            if (!grown) return NULL;
+            str = grown;
+            str->data = str->inline_data;
+        } else {
+            char* grown = realloc(str->data, capacity + 1);
+            if (!grown) return NULL;
+            str->data = grown;
+        }
+        str->capacity = capacity;
+        value_heap_allocations++;
+    }
+
+    memcpy(str->data + str->length, data, length);
+    str->length = needed;
+    str->data[needed] = '\0';
+    return str;
+}
+
+void string_release(String* str) {
+    if (!str || --str->refcount > 0) return;
+    if (str->data != str->inline_data) free(str->data);
+    free(str);
+}
@@ -0,0 +1,734 @@
+#include "value.h"
+#include "json.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+size_t value_alloc_count(void) {
+    return value_heap_allocations;
+}
+
+Value make_string(const char* data, size_t length) {
+    Value result = {0};
+    result.type = TYPE_STRING;
+    if (length <= VALUE_SMALL_MAX) {
+        memcpy(result.value.small, data, length);
+        result.value.small[length] = '\0';
+        result.array_size = (int)length;
+        return result;
+    }
+    return string_value(string_new(data, length));
+}
+
+Value string_value(String* str) {
+    Value result = {0};
+    result.type = TYPE_STRING;
+    if (!str) {
+        fprintf(stderr, "Error: Out of memory for string\n");
+        return result;
+    }
+    result.array_size = -1;
+    result.value.str = str;
+    return result;
+}
+
+Value adopt_string(char* buffer, size_t length) {
+    if (length <= VALUE_SMALL_MAX) {
+        Value result = make_string(buffer, length);
+        free(buffer);
+        return result;
+    }
+    return string_value(string_adopt(buffer, length));
+}
+
+String* value_to_string(const Value* value) {
+    if (value->array_size < 0) return string_retain(value->value.str);
+    return string_new(value->value.small, (size_t)value->array_size);
+}
+
+Value make_array(DataType type, int size) {
+    Value arr = {0};
+    if (size < 0) {
+        fprintf(stderr, "Error: Invalid array size\n");
+        arr.type = TYPE_VOID;
+        return arr;
+    }
+
+    arr.type = type;
+    arr.array_size = size;
+
+    void* data = NULL;
+    switch(type) {
+        case TYPE_ARRAY_INT:
+            data = arr.value.int_array = calloc(size, sizeof(int));
+            break;
+        case TYPE_ARRAY_FLOAT:
+            data = arr.value.float_array = calloc(size, sizeof(float));
+            break;
+        case TYPE_ARRAY_BOOL:
+            data = arr.value.bool_array = calloc(size, sizeof(bool));
+            break;
+        case TYPE_ARRAY_STRING:
+            data = arr.value.str_array = calloc(size, sizeof(String*));
+            break;
+        default:
+            arr.type = TYPE_VOID;
+            arr.array_size = 0;
+            return arr;
+    }
+
+    if (!data && size > 0) {
+        fprintf(stderr, "Error: Out of memory for array of %d elements\n", size);
+        arr.type = TYPE_VOID;
+        arr.array_size = 0;
+    } else {
+        value_heap_allocations++;
+    }
+    return arr;
+}
+
+Value array_load(const Value* arr, int index) {
+    Value result = {0};
+
+    switch(arr->type) {
+        case TYPE_ARRAY_INT:
+            result.type = TYPE_INT;
+            result.value.int_val = arr->value.int_array[index];
+            break;
+        case TYPE_ARRAY_FLOAT:
+            result.type = TYPE_FLOAT;
+            result.value.float_val = arr->value.float_array[index];
+            break;
+        case TYPE_ARRAY_BOOL:
+            result.type = TYPE_BOOLEAN;
+            result.value.bool_val = arr->value.bool_array[index];
+            break;
+        case TYPE_ARRAY_STRING: {
+            String* str = arr->value.str_array[index];
+            if (str) {
+                result = string_value(string_retain(str));
+            } else {
+                result.type = TYPE_STRING;
+            }
+            break;
+        }
+        default:
+            result.type = TYPE_VOID;
+            break;
+    }
+    return result;
+}
+
+// Fungsi untuk mengakses array
+bool array_get(const Value* arr, int index, Value* out) {
+    if (!arr || index < 0 || index >= arr->array_size) {
+        return false;
+    }
+
+    *out = array_load(arr, index);
+    return out->type != TYPE_VOID;
+}
+
+// Fungsi untuk mengubah nilai array
+bool array_set(Value* arr, int index, const Value* value) {
+    if (!arr || !value || index < 0 || index >= arr->array_size) {
+        return false;
+    }
+
+    switch(arr->type) {
+        case TYPE_ARRAY_INT:
+            if (value->type != TYPE_INT) return false;
+            arr->value.int_array[index] = value->value.int_val;
+            break;
+        case TYPE_ARRAY_FLOAT:
+            if (value->type != TYPE_FLOAT) return false;
+            arr->value.float_array[index] = value->value.float_val;
+            break;
+        case TYPE_ARRAY_BOOL:
+            if (value->type != TYPE_BOOLEAN) return false;
+            arr->value.bool_array[index] = value->value.bool_val;
+            break;
+        case TYPE_ARRAY_STRING:
+            if (value->type != TYPE_STRING) return false;
+            string_release(arr->value.str_array[index]);
+            arr->value.str_array[index] = value_to_string(value);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+// Tipe elemen untuk tipe array; TYPE_VOID kalau bukan array
+static DataType element_type(DataType type) {
+    switch (type) {
+        case TYPE_ARRAY_INT: return TYPE_INT;
+        case TYPE_ARRAY_FLOAT: return TYPE_FLOAT;
+        case TYPE_ARRAY_BOOL: return TYPE_BOOLEAN;
+        case TYPE_ARRAY_STRING: return TYPE_STRING;
+        default: return TYPE_VOID;
+    }
+}
+
+static bool check_array(const Value* arr) {
+    if (!arr || !is_array_type(arr->type)) {
+        fprintf(stderr, "Error: Invalid array access\n");
+        return false;
+    }
+    return true;
+}
+
+static bool check_numeric_array(const Value* arr) {
+    if (!check_array(arr)) return false;
+    if (arr->type != TYPE_ARRAY_INT && arr->type != TYPE_ARRAY_FLOAT) {
+        fprintf(stderr, "Error: Array must be int or float\n");
+        return false;
+    }
+    return true;
+}
+
+bool array_fill(Value* arr, const Value* value) {
+    if (!check_array(arr)) return false;
+    if (value->type != element_type(arr->type)) {
+        fprintf(stderr, "Error: Array element type mismatch\n");
+        return false;
+    }
+
+    int n = arr->array_size;
+    switch (arr->type) {
+        case TYPE_ARRAY_INT: {
+            int v = value->value.int_val;
+            for (int i = 0; i < n; i++) arr->value.int_array[i] = v;
+            break;
+        }
+        case TYPE_ARRAY_FLOAT: {
+            float v = value->value.float_val;
+            for (int i = 0; i < n; i++) arr->value.float_array[i] = v;
+            break;
+        }
+        case TYPE_ARRAY_BOOL:
+            memset(arr->value.bool_array, value->value.bool_val, n * sizeof(bool));
+            break;
+        default: {
+            // Semua elemen berbagi satu String
+            String* str = value_to_string(value);
+            if (!str) return false;
+            for (int i = 0; i < n; i++) {
+                string_release(arr->value.str_array[i]);
+                arr->value.str_array[i] = string_retain(str);
+            }
+            string_release(str);
+            break;
+        }
+    }
+    return true;
+}
+
+bool array_copy(Value* dst, const Value* src) {
+    if (!check_array(dst) || !check_array(src)) return false;
+    if (dst->type != src->type) {
+        fprintf(stderr, "Error: Array element type mismatch\n");
+        return false;
+    }
+    if (dst->value.int_array == src->value.int_array) return true;
+
+    int n = dst->array_size < src->array_size ? dst->array_size : src->array_size;
+    switch (dst->type) {
+        case TYPE_ARRAY_INT:
+            memcpy(dst->value.int_array, src->value.int_array, n * sizeof(int));
+            break;
+        case TYPE_ARRAY_FLOAT:
+            memcpy(dst->value.float_array, src->value.float_array, n * sizeof(float));
+            break;
+        case TYPE_ARRAY_BOOL:
+            memcpy(dst->value.bool_array, src->value.bool_array, n * sizeof(bool));
+            break;
+        default:
+            for (int i = 0; i < n; i++) {
+                String* str = src->value.str_array[i];
+                if (str) string_retain(str);
+                string_release(dst->value.str_array[i]);
+                dst->value.str_array[i] = str;
+            }
+            break;
+    }
+    return true;
+}
+
+Value array_sum(const Value* arr) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (!check_numeric_array(arr)) return result;
+
+    if (arr->type == TYPE_ARRAY_INT) {
+        // unsigned supaya overflow membungkus seperti + biasa, bukan UB
+        unsigned int total = 0;
+        for (int i = 0; i < arr->array_size; i++) total += (unsigned int)arr->value.int_array[i];
+        result.type = TYPE_INT;
+        result.value.int_val = (int)total;
+    } else {
+        double total = 0;
+        for (int i = 0; i < arr->array_size; i++) total += arr->value.float_array[i];
+        result.type = TYPE_FLOAT;
+        result.value.float_val = (float)total;
+    }
+    return result;
+}
+
+static Value array_extreme(const Value* arr, bool want_max) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (!check_numeric_array(arr)) return result;
+    if (arr->array_size == 0) {
+        fprintf(stderr, "Error: Empty array\n");
+        return result;
+    }
+
+    if (arr->type == TYPE_ARRAY_INT) {
+        const int* data = arr->value.int_array;
+        int best = data[0];
+        for (int i = 1; i < arr->array_size; i++) {
+            if (want_max ? data[i] > best : data[i] < best) best = data[i];
+        }
+        result.type = TYPE_INT;
+        result.value.int_val = best;
+    } else {
+        const float* data = arr->value.float_array;
+        float best = data[0];
+        for (int i = 1; i < arr->array_size; i++) {
+            if (want_max ? data[i] > best : data[i] < best) best = data[i];
+        }
+        result.type = TYPE_FLOAT;
+        result.value.float_val = best;
+    }
+    return result;
+}
+
+Value array_min(const Value* arr) {
+    return array_extreme(arr, false);
+}
+
+Value array_max(const Value* arr) {
+    return array_extreme(arr, true);
+}
+
+Value array_dot(const Value* left, const Value* right) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    if (!check_numeric_array(left) || !check_numeric_array(right)) return result;
+    if (left->type != right->type) {
+        fprintf(stderr, "Error: Array element type mismatch\n");
+        return result;
+    }
+    if (left->array_size != right->array_size) {
+        fprintf(stderr, "Error: Array size mismatch\n");
+        return result;
+    }
+
+    int n = left->array_size;
+    if (left->type == TYPE_ARRAY_INT) {
+        unsigned int total = 0;
+        for (int i = 0; i < n; i++) {
+            total += (unsigned int)left->value.int_array[i] * (unsigned int)right->value.int_array[i];
+        }
+        result.type = TYPE_INT;
+        result.value.int_val = (int)total;
+    } else {
+        double total = 0;
+        for (int i = 0; i < n; i++) {
+            total += (double)left->value.float_array[i] * right->value.float_array[i];
+        }
+        result.type = TYPE_FLOAT;
+        result.value.float_val = (float)total;
+    }
+    return result;
+}
+
+void release_value(Value* value) {
+    if (!value) return;
+
+    switch(value->type) {
+        case TYPE_STRING:
+        case TYPE_HTTP_RESPONSE:  // Handle sama seperti string
+            if (value->array_size < 0) string_release(value->value.str);
+            break;
+        case TYPE_ARRAY_INT:
+            if (value->value.int_array) free(value->value.int_array);
+            break;
+        case TYPE_ARRAY_FLOAT:
+            if (value->value.float_array) free(value->value.float_array);
+            break;
+        case TYPE_ARRAY_STRING:
+            if (value->value.str_array) {
+                for (int i = 0; i < value->array_size; i++) {
+                    string_release(value->value.str_array[i]);
+                }
+                free(value->value.str_array);
+            }
+            break;
+        case TYPE_ARRAY_BOOL:
+            if (value->value.bool_array) free(value->value.bool_array);
+            break;
+        case TYPE_JSON:
+            json_release(value->value.json.doc);
+            break;
+        // Primitive types don't need cleanup
+        case TYPE_INT:
+        case TYPE_FLOAT:
+        case TYPE_BOOLEAN:
+        case TYPE_VOID:
+            break;
+    }
+    value->type = TYPE_VOID;
+}
+
+Value copy_value(const Value* value) {
+    Value copy = *value;
+
+    switch(value->type) {
+        case TYPE_STRING:
+        case TYPE_HTTP_RESPONSE:
+            // String immutable, jadi salinan cukup berbagi
+            if (value->array_size < 0) string_retain(value->value.str);
+            break;
+        case TYPE_ARRAY_INT:
+            value_heap_allocations++;
+            copy.value.int_array = malloc(value->array_size * sizeof(int));
+            memcpy(copy.value.int_array, value->value.int_array, value->array_size * sizeof(int));
+            break;
+        case TYPE_ARRAY_FLOAT:
+            value_heap_allocations++;
+            copy.value.float_array = malloc(value->array_size * sizeof(float));
+            memcpy(copy.value.float_array, value->value.float_array, value->array_size * sizeof(float));
+            break;
+        case TYPE_ARRAY_BOOL:
+            value_heap_allocations++;
+            copy.value.bool_array = malloc(value->array_size * sizeof(bool));
+            memcpy(copy.value.bool_array, value->value.bool_array, value->array_size * sizeof(bool));
+            break;
+        case TYPE_ARRAY_STRING:
+            value_heap_allocations++;
+            copy.value.str_array = malloc(value->array_size * sizeof(String*));
+            for (int i = 0; i < value->array_size; i++) {
+                String* str = value->value.str_array[i];
+                copy.value.str_array[i] = str ? string_retain(str) : NULL;
+            }
+            break;
+        case TYPE_JSON:
+            // Dokumen tidak pernah diubah, jadi salinan cukup berbagi
+            json_retain(value->value.json.doc);
+            break;
+        default:
+            break;
+    }
+    return copy;
+}
+
+typedef Value (*BinaryHandler)(const Value* left, const Value* right);
+
+static Value make_int(int value) {
+    Value result = {0};
+    result.type = TYPE_INT;
+    result.value.int_val = value;
+    return result;
+}
+
+static Value make_float(float value) {
+    Value result = {0};
+    result.type = TYPE_FLOAT;
+    result.value.float_val = value;
+    return result;
+}
+
+static Value make_bool(bool value) {
+    Value result = {0};
+    result.type = TYPE_BOOLEAN;
+    result.value.bool_val = value;
+    return result;
+}
+
+static Value int_add(const Value* l, const Value* r) { return make_int(l->value.int_val + r->value.int_val); }
+static Value int_sub(const Value* l, const Value* r) { return make_int(l->value.int_val - r->value.int_val); }
+static Value int_mul(const Value* l, const Value* r) { return make_int(l->value.int_val * r->value.int_val); }
+static Value int_lt(const Value* l, const Value* r) { return make_bool(l->value.int_val < r->value.int_val); }
+static Value int_gt(const Value* l, const Value* r) { return make_bool(l->value.int_val > r->value.int_val); }
+
+static Value int_div(const Value* l, const Value* r) {
+    if (r->value.int_val == 0) {
+        fprintf(stderr, "Error: Division by zero\n");
+        return make_int(0);
+    }
+    return make_int(l->value.int_val / r->value.int_val);
+}
+
+static Value float_add(const Value* l, const Value* r) { return make_float(l->value.float_val + r->value.float_val); }
+static Value float_sub(const Value* l, const Value* r) { return make_float(l->value.float_val - r->value.float_val); }
+static Value float_mul(const Value* l, const Value* r) { return make_float(l->value.float_val * r->value.float_val); }
+static Value float_div(const Value* l, const Value* r) { return make_float(l->value.float_val / r->value.float_val); }
+static Value float_lt(const Value* l, const Value* r) { return make_bool(l->value.float_val < r->value.float_val); }
+static Value float_gt(const Value* l, const Value* r) { return make_bool(l->value.float_val > r->value.float_val); }
+
+static Value string_add(const Value* l, const Value* r) {
+    size_t left_len = value_strlen(l);
+    size_t right_len = value_strlen(r);
+    if (right_len == 0) return copy_value(l);
+    if (left_len == 0) return copy_value(r);
+
+    size_t length = left_len + right_len;
+    if (length <= VALUE_SMALL_MAX) {
+        Value result = make_string(value_cstr(l), left_len);
+        memcpy(result.value.small + left_len, value_cstr(r), right_len + 1);
+        result.array_size = (int)length;
+        return result;
+    }
+
+    String* str = string_alloc(length);
+    if (str) {
+        memcpy(str->data, value_cstr(l), left_len);
+        memcpy(str->data + left_len, value_cstr(r), right_len);
+    }
+    return string_value(str);
+}
+
+void append_string(Value* target, const Value* right) {
+    size_t right_len = value_strlen(right);
+    if (right_len == 0) return;
+
+    // right boleh berbagi String dengan target (s + s); jalur salin saja
+    String* str = target->array_size < 0 ? target->value.str : NULL;
+    if (str && str->refcount == 1 && !(right->array_size < 0 && right->value.str == str)) {
+        String* grown = string_append(str, value_cstr(right), right_len);
+        if (grown) {
+            target->value.str = grown;
+            return;
+        }
+    }
+
+    Value result = string_add(target, right);
+    release_value(target);
+    *target = result;
+}
+
+// Baris = tipe kedua operand (harus sama), kolom = operator
+static const BinaryHandler binary_handlers[TYPE_COUNT][BINOP_COUNT] = {
+    [TYPE_INT] = {
+        [BINOP_ADD] = int_add, [BINOP_SUB] = int_sub, [BINOP_MUL] = int_mul,
+        [BINOP_DIV] = int_div, [BINOP_LT] = int_lt, [BINOP_GT] = int_gt,
+    },
+    [TYPE_FLOAT] = {
+        [BINOP_ADD] = float_add, [BINOP_SUB] = float_sub, [BINOP_MUL] = float_mul,
+        [BINOP_DIV] = float_div, [BINOP_LT] = float_lt, [BINOP_GT] = float_gt,
+    },
+    [TYPE_STRING] = {
+        [BINOP_ADD] = string_add,
+    },
+};
+
+Value binary_operation(BinaryOperator op, const Value* left, const Value* right) {
+    if (left->type == right->type) {
+        BinaryHandler handler = binary_handlers[left->type][op];
+        if (handler) {
+            return handler(left, right);
+        }
+    }
+
+    Value result = {0};
+    return result;
+}
+
+// Tambahkan fungsi untuk process escape sequences
+char* process_string(const char* input) {
+    if (!input) return NULL;
+
+    int len = strlen(input);
+    char* output = malloc(len + 1);
+    int j = 0;
+
+    for (int i = 0; i < len; i++) {
+        if (input[i] == '\\' && i + 1 < len) {
+            switch (input[i + 1]) {
+                case 'n':
+                    output[j++] = '\n';
+                    i++;
+                    break;
+                case 't':
+                    output[j++] = '\t';
+                    i++;
+                    break;
+                case '\\':
+                    output[j++] = '\\';
+                    i++;
+                    break;
+                case '"':
+                    output[j++] = '"';
+                    i++;
+                    break;
+                default:
+                    output[j++] = input[i];
+            }
+        } else {
+            output[j++] = input[i];
+        }
+    }
+    output[j] = '\0';
+    return output;
+}
+
+static void write_indent(Output* out, int indent) {
+    if (indent > 0) output_repeat(out, ' ', (size_t)indent);
+}
+
+// Format JSON untuk cetak. Potongan tanpa karakter struktural disalin
+// sekaligus ke buffer keluaran, bukan per karakter.
+static void print_formatted_json(Output* out, const char* json, size_t len) {
+    int indent = 0;
+    bool in_string = false;
+    size_t i = 0;
+
+    while (i < len) {
+        char c = json[i];
+
+        // Handle string literals
+        if (c == '"' && (i == 0 || json[i-1] != '\\')) {
+            in_string = !in_string;
+            output_char(out, c);
+            i++;
+            continue;
+        }
+
+        if (in_string) {
+            size_t end = i + 1;
+            while (end < len && !(json[end] == '"' && json[end-1] != '\\')) end++;
+            output_write(out, json + i, end - i);
+            i = end;
+            continue;
+        }
+
+        switch (c) {
+            case '{':
+            case '[':
+                output_char(out, c);
+                output_char(out, '\n');
+                indent += 2;
+                write_indent(out, indent);
+                break;
+
+            case '}':
+            case ']':
+                output_char(out, '\n');
+                indent -= 2;
+                write_indent(out, indent);
+                output_char(out, c);
+                break;
+
+            case ',':
+                output_char(out, c);
+                output_char(out, '\n');
+                write_indent(out, indent);
+                break;
+
+            case ':':
+                output_write(out, ": ", 2);
+                break;
+
+            default: {
+                size_t end = i + 1;
+                while (end < len && !strchr("{}[],:\"", json[end])) end++;
+                output_write(out, json + i, end - i);
+                i = end;
+                continue;
+            }
+        }
+        i++;
+    }
+    output_char(out, '\n');
+}
+
+static void print_separator(Output* out, int index, int size) {
+    if (index < size - 1) output_write(out, ", ", 2);
+}
+
+void print_text(Output* out, const char* text, size_t length) {
+    if (length > 0 && (text[0] == '{' || text[0] == '[')) {
+        print_formatted_json(out, text, length);
+    } else {
+        output_write(out, text, length);
+        output_char(out, '\n');
+    }
+    output_end(out);
+}
+
+// Update fungsi cetak untuk handle JSON
+void print_value(Output* out, Value arg) {
+    switch (arg.type) {
+        case TYPE_STRING:
+        case TYPE_HTTP_RESPONSE:
+            print_text(out, value_cstr(&arg), value_strlen(&arg));
+            return;
+
+        case TYPE_INT:
+            output_int(out, arg.value.int_val);
+            output_char(out, '\n');
+            break;
+
+        case TYPE_FLOAT:
+            output_float(out, arg.value.float_val);
+            output_char(out, '\n');
+            break;
+
+        case TYPE_BOOLEAN:
+            output_str(out, arg.value.bool_val ? "benar\n" : "salah\n");
+            break;
+
+        case TYPE_ARRAY_INT:
+            output_char(out, '[');
+            for (int i = 0; i < arg.array_size; i++) {
+                output_int(out, arg.value.int_array[i]);
+                print_separator(out, i, arg.array_size);
+            }
+            output_write(out, "]\n", 2);
+            break;
+
+        case TYPE_ARRAY_FLOAT:
+            output_char(out, '[');
+            for (int i = 0; i < arg.array_size; i++) {
+                output_float(out, arg.value.float_array[i]);
+                print_separator(out, i, arg.array_size);
+            }
+            output_write(out, "]\n", 2);
+            break;
+
+        case TYPE_ARRAY_BOOL:
+            output_char(out, '[');
+            for (int i = 0; i < arg.array_size; i++) {
+                output_str(out, arg.value.bool_array[i] ? "benar" : "salah");
+                print_separator(out, i, arg.array_size);
+            }
+            output_write(out, "]\n", 2);
+            break;
+
+        case TYPE_ARRAY_STRING:
+            output_char(out, '[');
+            for (int i = 0; i < arg.array_size; i++) {
+                output_char(out, '"');
+                String* str = arg.value.str_array[i];
+                if (str) output_write(out, str->data, str->length);
+                output_char(out, '"');
+                print_separator(out, i, arg.array_size);
+            }
+            output_write(out, "]\n", 2);
+            break;
+
+        case TYPE_JSON: {
+            size_t length;
+            const char* text = json_text(&arg, &length);
+            print_formatted_json(out, text, length);
+            break;
+        }
+
+        case TYPE_VOID:
+            output_str(out, "void\n");
+            break;
+    }
+    output_end(out);
+}
@@ -0,0 +1,494 @@
+#include "vm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Dispatch pakai computed goto kalau compiler mendukung (GCC/Clang)
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO 1
+#endif
+
+VM* create_vm(void) {
+    VM* vm = create_vm_shared(create_http_client(), STDOUT_FILENO);
+    if (vm) vm->owns_http = true;
+    return vm;
+}
+
+static Value call_from_builtin(BuiltinContext* context, int index, Value* args, int argc);
+
+VM* create_vm_shared(HttpClient* http, int out_fd) {
+    VM* vm = (VM*)malloc(sizeof(VM));
+    if (!vm) return NULL;
+    vm->registers = NULL;
+    vm->register_count = 0;
+    vm->register_capacity = 0;
+    vm->frames = NULL;
+    vm->frame_count = 0;
+    vm->max_depth = MAX_CALL_DEPTH;
+    vm->aborted = false;
+    vm->interrupt = NULL;
+    vm->http = http;
+    vm->owns_http = false;
+    vm->chunk = NULL;
+    vm->out = create_output(out_fd);
+    vm->builtins = (BuiltinContext){ http, vm->out, vm, call_from_builtin };
+    vm->native_top = NULL;
+    return vm;
+}
+
+void free_vm(VM* vm) {
+    if (vm) {
+        for (int i = 0; i < vm->register_count; i++) {
+            release_value(&vm->registers[i]);
+        }
+        free(vm->registers);
+        free(vm->frames);
+        if (vm->owns_http) free_http_client(vm->http);
+        free_output(vm->out);
+        free(vm);
+    }
+}
+
+static inline bool owns_memory(DataType type) {
+    return type == TYPE_STRING || type == TYPE_HTTP_RESPONSE || type >= TYPE_ARRAY_INT;
+}
+
+// Ganti isi register; isi lama dibebaskan setelah nilai baru siap
+static inline void store(Value* reg, Value value) {
+    if (owns_memory(reg->type)) release_value(reg);
+    *reg = value;
+}
+
+static inline void store_int(Value* reg, int value) {
+    if (owns_memory(reg->type)) release_value(reg);
+    reg->type = TYPE_INT;
+    reg->value.int_val = value;
+}
+
+static inline void store_bool(Value* reg, bool value) {
+    if (owns_memory(reg->type)) release_value(reg);
+    reg->type = TYPE_BOOLEAN;
+    reg->value.bool_val = value;
+}
+
+static Value vm_execute(VM* vm, const Instruction* ip, Value* R);
+
+static Value void_value(void) {
+    Value result = {0};
+    result.type = TYPE_VOID;
+    return result;
+}
+
+// true kalau program diminta berhenti dari luar; dispatch loop lalu
+// membongkar semua frame seperti error fatal
+static bool interrupted(VM* vm) {
+    if (!vm->interrupt || !*vm->interrupt) return false;
+    if (!vm->aborted) fprintf(stderr, "Error: Time limit exceeded\n");
+    vm->aborted = true;
+    return true;
+}
+
+// Siapkan frame function di base; argc argumen sudah ada di base[0..] dan
+// frame ini akan menjadi frame ke-depth. Register lain di frame bisa berisi
+// sisa register sementara pemanggil, jadi dikosongkan. false kalau batas
+// kedalaman terlewati atau stack penuh (error sudah dicetak).
+static bool enter_frame(VM* vm, const Function* function, Value* base, int argc, int depth) {
+    if (interrupted(vm)) return false;
+    if (depth > vm->max_depth) {
+        fprintf(stderr, "Error: Maximum call depth %d exceeded in '%s'\n",
+                vm->max_depth, function->name);
+        vm->aborted = true;
+        return false;
+    }
+    if (base + function->register_count > vm->registers + vm->register_capacity) {
+        fprintf(stderr, "Error: Call stack exhausted in '%s'\n", function->name);
+        vm->aborted = true;
+        return false;
+    }
+
+    int top = (int)(base - vm->registers) + function->register_count;
+    if (top > vm->register_count) vm->register_count = top;
+    for (int i = argc; i < function->register_count; i++) {
+        if (owns_memory(base[i].type)) release_value(&base[i]);
+        base[i].type = TYPE_INT;
+        base[i].value.int_val = 0;
+    }
+    return true;
+}
+
+static void release_frame(Value* base, int count) {
+    for (int i = 0; i < count; i++) {
+        if (owns_memory(base[i].type)) release_value(&base[i]);
+    }
+}
+
+// Panggil fungsi dari luar dispatch loop (main dan callback builtin).
+// Frame-nya tetap dicatat supaya callback bersarang ikut dibatasi.
+static Value call_function(VM* vm, int index, Value* base, int argc) {
+    const Function* function = &vm->chunk->functions[index];
+    if (vm->aborted || !enter_frame(vm, function, base, argc, vm->frame_count + 1)) {
+        release_frame(base, argc);
+        return void_value();
+    }
+
+    CallFrame* frame = &vm->frames[vm->frame_count++];
+    frame->return_ip = NULL;
+    frame->base = NULL;
+    frame->dst = 0;
+    frame->register_count = function->register_count;
+    Value result = vm_execute(vm, vm->chunk->code + function->entry, base);
+    vm->frame_count--;
+    return result;
+}
+
+// BuiltinContext.call: fungsi callback dijalankan di frame tepat di atas
+// argumen builtin yang sedang berjalan
+static Value call_from_builtin(BuiltinContext* context, int index, Value* args, int argc) {
+    VM* vm = context->engine;
+    const Function* function = &vm->chunk->functions[index];
+    Value* base = vm->native_top;
+    int count = argc < function->param_count ? argc : function->param_count;
+    // Stack penuh: argumen dibuang, enter_frame yang melaporkan error
+    if (base + function->register_count > vm->registers + vm->register_capacity) count = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (i < count) {
+            store(&base[i], args[i]);
+        } else {
+            release_value(&args[i]);
+        }
+    }
+    Value result = call_function(vm, index, base, count);
+    // Tail call bisa memperbesar frame-nya; semua register di atas base mati
+    release_frame(base, vm->register_count - (int)(base - vm->registers));
+    return result;
+}
+
+// main dijalankan di frame pertama, yang baru dilepas free_vm
+void vm_run(VM* vm, Chunk* chunk) {
+    if (!vm || !chunk) return;
+    if (chunk->main_function < 0) {
+        fprintf(stderr, "Error: Function 'main' not found\n");
+        return;
+    }
+
+    if (!vm->registers) {
+        size_t capacity = (size_t)vm->max_depth * VM_FRAME_RESERVE;
+        if (capacity < VM_STACK_SIZE) capacity = VM_STACK_SIZE;
+        vm->registers = calloc(capacity, sizeof(Value));
+        vm->register_capacity = vm->registers ? capacity : 0;
+    }
+    if (!vm->frames) vm->frames = calloc(vm->max_depth, sizeof(CallFrame));
+    if (!vm->registers || !vm->frames) {
+        fprintf(stderr, "Error: Stack untuk %d pemanggilan tidak bisa dialokasikan\n",
+                vm->max_depth);
+        return;
+    }
+
+    vm->chunk = chunk;
+    vm->frame_count = 0;
+    vm->aborted = false;
+    Value result = call_function(vm, chunk->main_function, vm->registers, 0);
+    release_value(&result);
+}
+
+// Jalankan frame R mulai dari ip. OP_CALLFN di dalamnya tidak memakai
+// rekursi C; yang kembali ke sini hanya OP_RETURN frame R sendiri.
+static Value vm_execute(VM* vm, const Instruction* ip, Value* R) {
+    Value* K = vm->chunk->constants;
+    const int entry_depth = vm->frame_count;
+    Instruction inst;
+
+#define RK(x) (((x) & RK_CONST) ? &K[(x) & RK_MAX] : &R[(x)])
+
+#ifdef VM_COMPUTED_GOTO
+    static void* dispatch_table[OP_COUNT] = {
+        [OP_LOADK] = &&op_OP_LOADK,
+        [OP_LOADI] = &&op_OP_LOADI,
+        [OP_MOVE] = &&op_OP_MOVE,
+        [OP_ADD] = &&op_OP_ADD,
+        [OP_SUB] = &&op_OP_SUB,
+        [OP_MUL] = &&op_OP_MUL,
+        [OP_DIV] = &&op_OP_DIV,
+        [OP_LT] = &&op_OP_LT,
+        [OP_GT] = &&op_OP_GT,
+        [OP_JMP] = &&op_OP_JMP,
+        [OP_JMPF] = &&op_OP_JMPF,
+        [OP_PRINT] = &&op_OP_PRINT,
+        [OP_NEWARRAY] = &&op_OP_NEWARRAY,
+        [OP_GETINDEX] = &&op_OP_GETINDEX,
+        [OP_SETINDEX] = &&op_OP_SETINDEX,
+        [OP_CALL] = &&op_OP_CALL,
+        [OP_CALLFN] = &&op_OP_CALLFN,
+        [OP_TAILCALL] = &&op_OP_TAILCALL,
+        [OP_RETURN] = &&op_OP_RETURN,
+    };
+#define DISPATCH() do { inst = *ip++; goto *dispatch_table[inst.op]; } while (0)
+#define CASE(name) op_##name:
+#else
+#define DISPATCH() goto dispatch
+#define CASE(name) case name:
+#endif
+
+// Operator biner: jalur cepat int/int, sisanya lewat tabel binary_operation
+#define ARITH_OP(name, binop, op) \
+    CASE(name) { \
+        const Value* b = RK(inst.b); \
+        const Value* c = RK(inst.c); \
+        if (b->type == TYPE_INT && c->type == TYPE_INT) { \
+            store_int(&R[inst.a], b->value.int_val op c->value.int_val); \
+        } else { \
+            store(&R[inst.a], binary_operation(binop, b, c)); \
+        } \
+        DISPATCH(); \
+    }
+
+#define COMPARE_OP(name, binop, op) \
+    CASE(name) { \
+        const Value* b = RK(inst.b); \
+        const Value* c = RK(inst.c); \
+        if (b->type == TYPE_INT && c->type == TYPE_INT) { \
+            store_bool(&R[inst.a], b->value.int_val op c->value.int_val); \
+        } else { \
+            store(&R[inst.a], binary_operation(binop, b, c)); \
+        } \
+        DISPATCH(); \
+    }
+
+    DISPATCH();
+
+#ifndef VM_COMPUTED_GOTO
+dispatch:
+    inst = *ip++;
+    switch ((OpCode)inst.op) {
+#endif
+
+    CASE(OP_LOADK) {
+        store(&R[inst.a], copy_value(&K[inst.sbx]));
+        DISPATCH();
+    }
+
+    CASE(OP_LOADI) {
+        store_int(&R[inst.a], inst.sbx);
+        DISPATCH();
+    }
+
+    CASE(OP_MOVE) {
+        if (inst.a != inst.b) {
+            store(&R[inst.a], copy_value(&R[inst.b]));
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_ADD) {
+        const Value* b = RK(inst.b);
+        const Value* c = RK(inst.c);
+        if (b->type == TYPE_INT && c->type == TYPE_INT) {
+            store_int(&R[inst.a], b->value.int_val + c->value.int_val);
+        } else if (inst.a == inst.b && b->type == TYPE_STRING && c->type == TYPE_STRING) {
+            // s = s + x: tambah di tempat kalau String hanya milik register ini
+            append_string(&R[inst.a], c);
+        } else {
+            store(&R[inst.a], binary_operation(BINOP_ADD, b, c));
+        }
+        DISPATCH();
+    }
+
+    ARITH_OP(OP_SUB, BINOP_SUB, -)
+    ARITH_OP(OP_MUL, BINOP_MUL, *)
+
+    CASE(OP_DIV) {
+        const Value* b = RK(inst.b);
+        const Value* c = RK(inst.c);
+        if (b->type == TYPE_INT && c->type == TYPE_INT) {
+            if (c->value.int_val == 0) {
+                fprintf(stderr, "Error: Division by zero\n");
+                store_int(&R[inst.a], 0);
+            } else {
+                store_int(&R[inst.a], b->value.int_val / c->value.int_val);
+            }
+        } else {
+            store(&R[inst.a], binary_operation(BINOP_DIV, b, c));
+        }
+        DISPATCH();
+    }
+
+    COMPARE_OP(OP_LT, BINOP_LT, <)
+    COMPARE_OP(OP_GT, BINOP_GT, >)
+
+    CASE(OP_JMP) {
+        // Lompatan mundur hanya ada di akhir body ulang
+        if (inst.sbx < 0 && interrupted(vm)) goto abort;
+        ip += inst.sbx;
+        DISPATCH();
+    }
+
+    CASE(OP_JMPF) {
+        const Value* cond = &R[inst.a];
+        if (cond->type != TYPE_BOOLEAN) {
+            fprintf(stderr, inst.n ? "Error: While condition must be boolean\n"
+                                   : "Error: If condition must be boolean\n");
+            ip += inst.sbx;
+        } else if (!cond->value.bool_val) {
+            ip += inst.sbx;
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_PRINT) {
+        print_value(vm->out, *RK(inst.b));
+        DISPATCH();
+    }
+
+    CASE(OP_NEWARRAY) {
+        const Value* size = RK(inst.b);
+        if (size->type != TYPE_INT) {
+            fprintf(stderr, "Error: Array size must be an integer\n");
+            store(&R[inst.a], void_value());
+        } else {
+            store(&R[inst.a], make_array((DataType)inst.n, size->value.int_val));
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_GETINDEX) {
+        const Value* arr = &R[inst.b];
+        const Value* index = RK(inst.c);
+        Value item;
+        if (!is_array_type(arr->type)) {
+            fprintf(stderr, "Error: Invalid array access\n");
+            store_int(&R[inst.a], 0);
+        } else if (index->type != TYPE_INT) {
+            fprintf(stderr, "Error: Array index must be an integer\n");
+            store_int(&R[inst.a], 0);
+        } else if (!array_get(arr, index->value.int_val, &item)) {
+            fprintf(stderr, "Error: Array index out of bounds\n");
+            store_int(&R[inst.a], 0);
+        } else {
+            store(&R[inst.a], item);
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_SETINDEX) {
+        Value* arr = &R[inst.a];
+        const Value* index = RK(inst.b);
+        if (!is_array_type(arr->type)) {
+            fprintf(stderr, "Error: Invalid array access\n");
+        } else if (index->type != TYPE_INT) {
+            fprintf(stderr, "Error: Array index must be an integer\n");
+        } else if (index->value.int_val < 0 || index->value.int_val >= arr->array_size) {
+            fprintf(stderr, "Error: Array index out of bounds\n");
+        } else if (!array_set(arr, index->value.int_val, RK(inst.c))) {
+            fprintf(stderr, "Error: Array element type mismatch\n");
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_CALL) {
+        const Builtin* builtin = builtin_at(inst.b);
+        Value* args = &R[inst.c];
+        // Argumen yang dipinjam berisi nomor register array-nya
+        if (builtin->borrowed) {
+            for (int i = 0; i < inst.n; i++) {
+                if (builtin->borrowed & (1u << i)) args[i] = R[args[i].value.int_val];
+            }
+        }
+
+        Value* caller_top = vm->native_top;
+        vm->native_top = args + inst.n;
+        Value result = builtin->fn(&vm->builtins, args, inst.n);
+        vm->native_top = caller_top;
+
+        // Argumen sementara tidak dipakai lagi setelah pemanggilan; salinan
+        // array pinjaman cukup dilupakan
+        for (int i = 0; i < inst.n; i++) {
+            if (builtin->borrowed & (1u << i)) {
+                args[i].type = TYPE_VOID;
+            } else {
+                release_value(&args[i]);
+            }
+        }
+        store(&R[inst.a], result);
+        if (vm->aborted) goto abort;
+        DISPATCH();
+    }
+
+    CASE(OP_CALLFN) {
+        const Function* function = &vm->chunk->functions[inst.b];
+        Value* base = &R[inst.c];
+        if (!enter_frame(vm, function, base, inst.n, vm->frame_count + 1)) goto abort;
+
+        CallFrame* frame = &vm->frames[vm->frame_count++];
+        frame->return_ip = ip;
+        frame->base = R;
+        frame->dst = inst.a;
+        frame->register_count = function->register_count;
+        R = base;
+        ip = vm->chunk->code + function->entry;
+        DISPATCH();
+    }
+
+    CASE(OP_TAILCALL) {
+        // Frame ini dipakai ulang: register lama dilepas, argumen digeser
+        // ke R[0..] dan fungsi baru mulai tanpa menambah kedalaman
+        const Function* function = &vm->chunk->functions[inst.b];
+        CallFrame* frame = &vm->frames[vm->frame_count - 1];
+        if (inst.c > 0) {
+            release_frame(R, inst.c);
+            for (int i = 0; i < inst.n; i++) {
+                R[i] = R[inst.c + i];
+                R[inst.c + i].type = TYPE_VOID;
+            }
+        }
+        release_frame(&R[inst.n], frame->register_count - inst.n);
+        if (!enter_frame(vm, function, R, inst.n, vm->frame_count)) goto abort;
+        frame->register_count = function->register_count;
+        ip = vm->chunk->code + function->entry;
+        DISPATCH();
+    }
+
+    CASE(OP_RETURN) {
+        Value result = void_value();
+        if (inst.n) {
+            // Register frame ini akan dilepas, jadi nilainya cukup dipindah
+            if (inst.b & RK_CONST) {
+                result = copy_value(RK(inst.b));
+            } else {
+                result = R[inst.b];
+                R[inst.b].type = TYPE_VOID;
+            }
+        }
+        if (vm->frame_count == entry_depth) return result;
+
+        CallFrame* frame = &vm->frames[--vm->frame_count];
+        release_frame(R, frame->register_count);
+        ip = frame->return_ip;
+        R = frame->base;
+        store(&R[frame->dst], result);
+        DISPATCH();
+    }
+
+#ifndef VM_COMPUTED_GOTO
+    default:
+        return void_value();
+    }
+#endif
+
+abort:
+    // Error fatal: lepas frame yang dibuka di sini; frame R pertama milik
+    // pemanggil vm_execute
+    while (vm->frame_count > entry_depth) {
+        CallFrame* frame = &vm->frames[--vm->frame_count];
+        release_frame(R, frame->register_count);
+        R = frame->base;
+    }
+    return void_value();
+
+#undef RK
+#undef DISPATCH
+#undef CASE
+#undef ARITH_OP
+#undef COMPARE_OP
+}